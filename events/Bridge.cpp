@@ -0,0 +1,205 @@
+#include "Bridge.hpp"
+
+#include <new>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace LB
+{
+	namespace events
+	{
+		namespace
+		{
+			constexpr char MAGIC[8] = {'L', 'B', 'e', 'v', 'B', 'r', 'g', '1'};
+			constexpr std::size_t LINE = 64;
+
+			[[noreturn]] void fail(char const *what)
+			{
+				throw std::system_error{errno, std::system_category(), what};
+			}
+
+			auto header_size() noexcept
+			-> std::size_t
+			{
+				return (sizeof(impl::BridgeRing::Header) + LINE - 1)/LINE*LINE;
+			}
+			void map(impl::BridgeRing &ring, int fd, std::size_t size, int protection)
+			{
+				void *p = ::mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+				if(p == MAP_FAILED)
+				{
+					fail("mmap");
+				}
+				ring.header = static_cast<impl::BridgeRing::Header *>(p);
+				ring.slots = static_cast<unsigned char *>(p) + header_size();
+				ring.mapped = size;
+			}
+		}
+
+		BridgePublisher::BridgePublisher(std::string const &n, std::size_t capacity, std::size_t payload)
+		: name{n}
+		{
+			std::size_t slots = 1;
+			while(slots < capacity)
+			{
+				slots *= 2;
+			}
+			//Whole cache lines, so that writing one slot never disturbs readers of the next
+			auto const stride = (sizeof(impl::BridgeRing::Slot) + payload + LINE - 1)/LINE*LINE;
+			auto const size = header_size() + slots*stride;
+
+			::shm_unlink(name.c_str());
+			int const fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+			if(fd < 0)
+			{
+				fail("shm_open");
+			}
+			if(::ftruncate(fd, static_cast<off_t>(size)) != 0)
+			{
+				::close(fd);
+				::shm_unlink(name.c_str());
+				fail("ftruncate");
+			}
+			try
+			{
+				map(ring, fd, size, PROT_READ | PROT_WRITE);
+			}
+			catch(...)
+			{
+				::close(fd);
+				::shm_unlink(name.c_str());
+				throw;
+			}
+			::close(fd);
+
+			//The new object is zero filled, so every slot already reads as not yet written
+			auto const h = new(ring.header) impl::BridgeRing::Header{{}, static_cast<std::uint32_t>(slots), static_cast<std::uint32_t>(stride), {0}};
+			for(std::size_t i = 0; i < slots; ++i)
+			{
+				new(ring.slots + i*stride) impl::BridgeRing::Slot{{0}, 0, 0};
+			}
+			//Published last, so a subscriber which sees the magic sees the rest of the header
+			std::atomic_thread_fence(std::memory_order_release);
+			std::memcpy(h->magic, MAGIC, sizeof(MAGIC));
+		}
+		BridgePublisher::~BridgePublisher() noexcept
+		{
+			reactors.clear();
+			::munmap(ring.header, ring.mapped);
+			::shm_unlink(name.c_str());
+		}
+
+		auto BridgePublisher::written() const noexcept
+		-> std::uint64_t
+		{
+			return ring.header->head.load(std::memory_order_acquire);
+		}
+
+		void BridgePublisher::write(BridgeType_t type, void const *data, std::size_t size) noexcept
+		{
+			std::lock_guard<std::mutex> const lock {m};
+			auto const n = ring.header->head.load(std::memory_order_relaxed);
+			auto &s = ring.slot(n);
+			s.seq.store(0, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			s.type = type;
+			s.size = static_cast<std::uint32_t>(size);
+			std::memcpy(reinterpret_cast<unsigned char *>(&s + 1), data, size);
+			s.seq.store(n + 1, std::memory_order_release);
+			ring.header->head.store(n + 1, std::memory_order_release);
+		}
+
+		BridgeSubscriber::BridgeSubscriber(std::string const &name)
+		{
+			int const fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+			if(fd < 0)
+			{
+				fail("shm_open");
+			}
+			struct stat st;
+			if(::fstat(fd, &st) != 0)
+			{
+				::close(fd);
+				fail("fstat");
+			}
+			auto const size = static_cast<std::size_t>(st.st_size);
+			if(size < header_size())
+			{
+				::close(fd);
+				throw std::runtime_error{"not an event bridge: " + name};
+			}
+			try
+			{
+				map(ring, fd, size, PROT_READ);
+			}
+			catch(...)
+			{
+				::close(fd);
+				throw;
+			}
+			::close(fd);
+			if(std::memcmp(ring.header->magic, MAGIC, sizeof(MAGIC)) != 0 || header_size() + std::size_t{ring.header->capacity}*ring.header->stride > size)
+			{
+				::munmap(ring.header, ring.mapped);
+				throw std::runtime_error{"not an event bridge: " + name};
+			}
+			std::atomic_thread_fence(std::memory_order_acquire);
+			buffer.resize(ring.payload());
+			next = ring.header->head.load(std::memory_order_acquire);
+		}
+		BridgeSubscriber::~BridgeSubscriber() noexcept
+		{
+			::munmap(ring.header, ring.mapped);
+		}
+
+		auto BridgeSubscriber::poll(std::size_t max)
+		-> std::size_t
+		{
+			std::size_t n = 0;
+			std::uint64_t const capacity = ring.header->capacity;
+			while(n < max)
+			{
+				auto const &s = ring.slot(next);
+				auto const seq = s.seq.load(std::memory_order_acquire);
+				if(seq != next + 1)
+				{
+					auto const head = ring.header->head.load(std::memory_order_acquire);
+					if(head <= next)
+					{
+						break; //nothing new
+					}
+					if(seq <= next + 1 && head - next <= capacity)
+					{
+						break; //still being written
+					}
+					//Lapped: the slot for head may be being written, so the oldest intact entry is
+					//the one after it
+					auto const oldest = head - capacity + 1;
+					missed += oldest - next;
+					next = oldest;
+					continue;
+				}
+				auto const type = s.type;
+				auto const size = s.size;
+				std::memcpy(buffer.data(), reinterpret_cast<unsigned char const *>(&s + 1), size < buffer.size()? size : buffer.size());
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if(s.seq.load(std::memory_order_relaxed) != seq)
+				{
+					continue; //overwritten while copying, so lapped
+				}
+				++next;
+				auto const l = loaders.find(type);
+				if(l != loaders.end() && l->second.size == size)
+				{
+					l->second.load(buffer.data());
+					++n;
+				}
+			}
+			return n;
+		}
+	}
+}
@@ -0,0 +1,201 @@
+#ifndef LB_events_Bridge_HeaderPlusPlus
+#define LB_events_Bridge_HeaderPlusPlus
+
+#include "Event.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace LB
+{
+	namespace events
+	{
+		//Event types sent through a bridge must have
+		//  static constexpr LB::events::BridgeType_t BRIDGE_TYPE = /*an id unique among your events*/;
+		//  auto payload() const -> /*a trivially copyable type*/;
+		//  static auto load(/*that type*/ const &p) -> /*the event type*/;
+		//where load() rebuilds the event from what payload() returned, in another process.
+		using BridgeType_t = std::uint32_t;
+
+		namespace impl
+		{
+			//The shared memory both sides map: a header, then a ring of fixed-size slots. Each
+			//slot is its own seqlock, so readers never write to the shared memory at all.
+			struct BridgeRing final
+			{
+				static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "the ring needs address-free atomics");
+
+				struct Header final
+				{
+					char magic[8];
+					std::uint32_t capacity; //a power of two
+					std::uint32_t stride; //bytes per slot
+					alignas(64) std::atomic<std::uint64_t> head; //sequence number of the next entry
+				};
+				struct Slot final
+				{
+					std::atomic<std::uint64_t> seq; //sequence number + 1 once written, 0 while being written
+					BridgeType_t type;
+					std::uint32_t size;
+					//followed by the payload
+				};
+
+				Header *header = nullptr;
+				unsigned char *slots = nullptr;
+				std::size_t mapped = 0;
+
+				auto slot(std::uint64_t n) const noexcept
+				-> Slot &
+				{
+					return *reinterpret_cast<Slot *>(slots + (n & (header->capacity - 1))*header->stride);
+				}
+				auto payload() const noexcept
+				-> std::size_t
+				{
+					return header->stride - sizeof(Slot);
+				}
+			};
+		}
+
+		//Publishes events to other processes on the same host through a ring in POSIX shared
+		//memory, which any number of BridgeSubscribers may read. Writing takes no system calls.
+		//When the ring is full the oldest entries are overwritten, and the subscribers which had
+		//not read them yet count them as lost.
+		struct BridgePublisher final
+		{
+			//Creates the shared memory object name (as for shm_open, e.g. "/my-app-events"),
+			//replacing any left behind, with room for capacity entries (rounded up to a power of
+			//two) whose payloads are at most payload bytes
+			explicit BridgePublisher(std::string const &name, std::size_t capacity = 1 << 12, std::size_t payload = 64);
+			BridgePublisher(BridgePublisher const &) = delete;
+			BridgePublisher &operator=(BridgePublisher const &) = delete;
+			BridgePublisher(BridgePublisher &&) = delete;
+			BridgePublisher &operator=(BridgePublisher &&) = delete;
+			//Removes the name; subscribers keep what they have already mapped
+			~BridgePublisher() noexcept;
+
+			//Publishes every EventT which reacts from now on, after its other reactors
+			template<typename EventT>
+			void publish()
+			{
+				check<EventT>();
+				reactors.emplace_back(new Publish<EventT>{*this});
+			}
+			//Publishes e once, whether or not it is ever called here
+			template<typename EventT>
+			void write(EventT const &e)
+			{
+				check<EventT>();
+				send(e);
+			}
+
+			//The number of entries written so far
+			auto written() const noexcept
+			-> std::uint64_t;
+
+		private:
+			template<typename EventT>
+			struct Publish final
+			: Reactor<EventT>
+			{
+				BridgePublisher &bridge;
+				Publish(BridgePublisher &b) noexcept
+				: Reactor<EventT>(ListenerPriority::LAST)
+				, bridge(b)
+				{
+				}
+				virtual void react(EventT const &e) noexcept(EventT::NOEXCEPT) override
+				{
+					bridge.send(e);
+				}
+			};
+
+			std::string const name;
+			impl::BridgeRing ring;
+			std::mutex m; //serializes writers, so there is a single producer
+			std::vector<std::unique_ptr<ReactorBase>> reactors;
+
+			template<typename EventT>
+			void check() const
+			{
+				using Payload_t = decltype(std::declval<EventT const &>().payload());
+				static_assert(std::is_trivially_copyable<Payload_t>::value, "the payload must be trivially copyable");
+				static_assert(std::is_same<decltype(EventT::BRIDGE_TYPE), BridgeType_t const>::value, "EventT needs a BRIDGE_TYPE");
+				if(sizeof(Payload_t) > ring.payload())
+				{
+					throw std::length_error{"payload too large for the bridge"};
+				}
+			}
+			template<typename EventT>
+			void send(EventT const &e) noexcept(EventT::NOEXCEPT)
+			{
+				auto const p = e.payload();
+				write(EventT::BRIDGE_TYPE, std::addressof(p), sizeof(p));
+			}
+			void write(BridgeType_t type, void const *data, std::size_t size) noexcept;
+		};
+
+		//Reads the entries of a BridgePublisher, possibly in another process, and calls them as
+		//local events through the usual listeners. Only the event types passed to subscribe<>()
+		//are called; the others are skipped.
+		struct BridgeSubscriber final
+		{
+			//Starts after the newest entry
+			explicit BridgeSubscriber(std::string const &name);
+			BridgeSubscriber(BridgeSubscriber const &) = delete;
+			BridgeSubscriber &operator=(BridgeSubscriber const &) = delete;
+			BridgeSubscriber(BridgeSubscriber &&) = delete;
+			BridgeSubscriber &operator=(BridgeSubscriber &&) = delete;
+			~BridgeSubscriber() noexcept;
+
+			template<typename EventT>
+			void subscribe()
+			{
+				using Payload_t = decltype(std::declval<EventT const &>().payload());
+				static_assert(std::is_trivially_copyable<Payload_t>::value, "the payload must be trivially copyable");
+				loaders[EventT::BRIDGE_TYPE] = {sizeof(Payload_t), [](unsigned char const *data)
+				{
+					Payload_t p;
+					std::memcpy(std::addressof(p), data, sizeof(p));
+					EventT::load(p).call();
+				}};
+			}
+
+			//Calls the entries written since the last poll, up to max of them, and returns how many
+			//it called. Never blocks and takes no system calls.
+			auto poll(std::size_t max = std::numeric_limits<std::size_t>::max())
+			-> std::size_t;
+
+			//The number of entries which were overwritten before this subscriber read them
+			auto lost() const noexcept
+			-> std::uint64_t
+			{
+				return missed;
+			}
+
+		private:
+			struct Loader final
+			{
+				std::size_t size;
+				void (*load)(unsigned char const *data);
+			};
+			std::unordered_map<BridgeType_t, Loader> loaders;
+			impl::BridgeRing ring;
+			std::vector<unsigned char> buffer; //one payload, copied out before it is checked
+			std::uint64_t next = 0;
+			std::uint64_t missed = 0;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,54 @@
+#include "Budgeted.hpp"
+
+namespace LB
+{
+	namespace events
+	{
+		BudgetedDispatcher::BudgetedDispatcher(ListenerPriority t, Overrun_t o) noexcept
+		: threshold{t}
+		, overrun{std::move(o)}
+		{
+		}
+		BudgetedDispatcher::~BudgetedDispatcher() noexcept
+		{
+			try
+			{
+				flush();
+			}
+			catch(...)
+			{
+			}
+		}
+
+		bool BudgetedDispatcher::run(Clock_t::time_point deadline)
+		{
+			Stop stop {Stop::DEADLINE, threshold, deadline};
+			bool const done = resume(stop);
+			auto const end = Clock_t::now();
+			if(stop.started && end > deadline && overrun)
+			{
+				overrun(end - deadline);
+			}
+			return done;
+		}
+		void BudgetedDispatcher::flush()
+		{
+			Stop stop {Stop::NEVER, threshold, {}};
+			resume(stop);
+		}
+
+		bool BudgetedDispatcher::resume(Stop &stop)
+		{
+			//Events called by reactors meanwhile are appended, and wait their turn
+			while(!pending.empty())
+			{
+				if(!pending.front()->react(stop))
+				{
+					return false;
+				}
+				pending.pop_front();
+			}
+			return true;
+		}
+	}
+}
@@ -0,0 +1,158 @@
+#ifndef LB_events_Budgeted_HeaderPlusPlus
+#define LB_events_Budgeted_HeaderPlusPlus
+
+#include "Event.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace LB
+{
+	namespace events
+	{
+		//Calls events without letting the react phase run past a deadline, for loops with a fixed
+		//budget per frame or tick. call() processes an event and reacts with every reactor whose
+		//priority is at most the threshold straight away; the rest react during later slices,
+		//in the order a plain call() would have used, and every event is still delivered.
+		//Like the Registrar, only usable from one thread at a time.
+		struct BudgetedDispatcher final
+		{
+			using Clock_t = std::chrono::steady_clock;
+			//Told how long after its deadline a slice which let any reactor react returned
+			using Overrun_t = std::function<void (Clock_t::duration overrun)>;
+
+			explicit BudgetedDispatcher(ListenerPriority threshold = ListenerPriority{}, Overrun_t overrun = {}) noexcept;
+			BudgetedDispatcher(BudgetedDispatcher const &) = delete;
+			BudgetedDispatcher &operator=(BudgetedDispatcher const &) = delete;
+			BudgetedDispatcher(BudgetedDispatcher &&) = delete;
+			BudgetedDispatcher &operator=(BudgetedDispatcher &&) = delete;
+			//Reacts with whatever is left before returning
+			~BudgetedDispatcher() noexcept;
+
+			//Events with a DirectReactor, such as a claimed Exclusive, react in full at once
+			template<typename EventT>
+			void call(EventT &&e)
+			{
+				using Event_t = typename std::decay<EventT>::type;
+				static_assert(std::is_base_of<Event, Event_t>::value, "EventT must derive from Event");
+				e.process();
+				if(!e.reactable())
+				{
+					return;
+				}
+				if(e.direct_reactor())
+				{
+					e.react();
+					return;
+				}
+				std::unique_ptr<Held<Event_t>> held {new Held<Event_t>{std::forward<EventT>(e)}};
+				Stop stop {Stop::INLINE, threshold, {}};
+				bool done;
+				try
+				{
+					done = held->react(stop);
+				}
+				catch(...)
+				{
+					//The reactor which threw counts as having reacted
+					pending.push_back(std::move(held));
+					throw;
+				}
+				if(!done)
+				{
+					pending.push_back(std::move(held));
+				}
+			}
+
+			//Resumes the remaining reactors in order, starting each only while the deadline has not
+			//passed, and returns whether none remain. A reactor which is still running when the
+			//deadline passes finishes first, and then the overrun is reported.
+			bool run(Clock_t::time_point deadline);
+			bool run_for(Clock_t::duration budget)
+			{
+				return run(Clock_t::now() + budget);
+			}
+			//Reacts with every remaining reactor
+			void flush();
+
+			//The number of events with reactors yet to react
+			auto size() const noexcept
+			-> std::size_t
+			{
+				return pending.size();
+			}
+			bool empty() const noexcept
+			{
+				return pending.empty();
+			}
+
+		private:
+			struct Stop final
+			{
+				enum Mode
+				{
+					INLINE,
+					DEADLINE,
+					NEVER
+				} mode;
+				ListenerPriority::Priority_t threshold;
+				Clock_t::time_point deadline;
+				bool started = false; //whether any reactor was let through
+
+				bool operator()(ListenerPriority::Priority_t priority) noexcept
+				{
+					if(mode == INLINE && priority > threshold)
+					{
+						return true;
+					}
+					if(mode == DEADLINE && Clock_t::now() >= deadline)
+					{
+						return true;
+					}
+					started = true;
+					return false;
+				}
+			};
+			struct Pending
+			{
+				virtual ~Pending() noexcept = default;
+				//Whether every reactor has reacted
+				virtual bool react(Stop &stop) = 0;
+			};
+			template<typename EventT>
+			struct Held final
+			: Pending
+			{
+				using Hierarchy_t = typename EventT::Hierarchy_t;
+				EventT e;
+				std::array<impl::ReactCursor, Hierarchy_t::LEVELS> cursors;
+				Held(EventT &&e)
+				: e(std::move(e))
+				{
+				}
+				Held(EventT const &e)
+				: e(e)
+				{
+				}
+				virtual bool react(Stop &stop) override
+				{
+					return Hierarchy_t::react(e, EventT::Registrar_t::template levels<false>(), cursors.data(), stop);
+				}
+			};
+
+			ListenerPriority::Priority_t const threshold;
+			Overrun_t const overrun;
+			std::deque<std::unique_ptr<Pending>> pending;
+
+			bool resume(Stop &stop);
+		};
+	}
+}
+
+#endif
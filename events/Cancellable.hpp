@@ -21,10 +21,21 @@ namespace LB
 				return cancel;
 			}
 
+			//Cancels for good: no further processor can call cancelled(false)
+			void cancel_final() noexcept
+			{
+				cancelled(true);
+				stop_processing();
+			}
+
 			virtual bool should_react(ReactorBase const &) const noexcept override
 			{
 				return !cancel;
 			}
+			virtual bool reactable() const noexcept override
+			{
+				return !cancel;
+			}
 
 		private:
 			bool cancel = false;
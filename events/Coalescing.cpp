@@ -0,0 +1,63 @@
+#include "Coalescing.hpp"
+
+namespace LB
+{
+	namespace events
+	{
+		CoalescingQueue::CoalescingQueue(Clock_t::duration b) noexcept
+		: bound{b}
+		{
+		}
+		CoalescingQueue::~CoalescingQueue() noexcept = default;
+
+		void CoalescingQueue::poll()
+		{
+			if(!pending.empty() && Clock_t::now() - oldest >= bound)
+			{
+				flush();
+			}
+		}
+		auto CoalescingQueue::flush()
+		-> std::size_t
+		{
+			auto batch = std::move(pending);
+			pending.clear();
+			index.clear();
+			std::size_t i = 0;
+			try
+			{
+				for(; i < batch.size(); ++i)
+				{
+					batch[i]->call();
+				}
+			}
+			catch(...)
+			{
+				//The rest go back in front of whatever was posted meanwhile
+				auto posted = std::move(pending);
+				pending.clear();
+				index.clear();
+				for(auto j = i + 1; j < batch.size(); ++j)
+				{
+					add(std::move(batch[j]));
+				}
+				for(auto &p : posted)
+				{
+					add(std::move(p));
+				}
+				throw;
+			}
+			return batch.size();
+		}
+
+		void CoalescingQueue::add(std::unique_ptr<Pending> p)
+		{
+			if(pending.empty())
+			{
+				oldest = Clock_t::now();
+			}
+			index[p->id] = pending.size();
+			pending.push_back(std::move(p));
+		}
+	}
+}
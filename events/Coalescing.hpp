@@ -0,0 +1,146 @@
+#ifndef LB_events_Coalescing_HeaderPlusPlus
+#define LB_events_Coalescing_HeaderPlusPlus
+
+#include "Event.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace LB
+{
+	namespace events
+	{
+		namespace impl
+		{
+			template<typename EventT>
+			auto coalesce(EventT &earlier, EventT &&later, int)
+			-> decltype(earlier.coalesce(std::move(later)))
+			{
+				return earlier.coalesce(std::move(later));
+			}
+			template<typename EventT>
+			void coalesce(EventT &earlier, EventT &&later, long)
+			{
+				earlier = std::move(later);
+			}
+		}
+
+		//Holds events until they are flushed, merging each one into the pending event of the same
+		//type and key() if there is one, so that bursts of events only get called once. Events
+		//with a member function coalesce(EventT &&later) merge through it, others are replaced by
+		//the later event. Flushing calls the events in the order their first instance was posted.
+		//Like the Registrar, only usable from one thread at a time.
+		struct CoalescingQueue final
+		{
+			using Clock_t = std::chrono::steady_clock;
+
+			//post() and poll() flush once the oldest pending event has waited longer than bound
+			explicit CoalescingQueue(Clock_t::duration bound = Clock_t::duration::max()) noexcept;
+			CoalescingQueue(CoalescingQueue const &) = delete;
+			CoalescingQueue &operator=(CoalescingQueue const &) = delete;
+			CoalescingQueue(CoalescingQueue &&) = delete;
+			CoalescingQueue &operator=(CoalescingQueue &&) = delete;
+			~CoalescingQueue() noexcept;
+
+			template<typename EventT>
+			void post(EventT &&e)
+			{
+				using Event_t = typename std::decay<EventT>::type;
+				static_assert(std::is_base_of<Event, Event_t>::value, "EventT must derive from Event");
+				Id const id {&impl::Level<Event_t>::tag, e.key()};
+				auto const it = index.find(id);
+				if(it != index.end())
+				{
+					Event_t later {std::forward<EventT>(e)};
+					impl::coalesce(static_cast<Held<Event_t> &>(*pending[it->second]).e, std::move(later), 0);
+					++merged;
+				}
+				else
+				{
+					add(std::unique_ptr<Pending>{new Held<Event_t>{id, std::forward<EventT>(e)}});
+				}
+				poll();
+			}
+
+			//Flushes if the time bound has run out
+			void poll();
+			//Calls the pending events and returns how many there were. Events posted meanwhile are
+			//left for the next flush. If an event throws, the ones after it stay pending.
+			auto flush()
+			-> std::size_t;
+
+			auto size() const noexcept
+			-> std::size_t
+			{
+				return pending.size();
+			}
+			//How many posted events have been merged into another so far
+			auto coalesced() const noexcept
+			-> std::size_t
+			{
+				return merged;
+			}
+
+		private:
+			struct Id final
+			{
+				void const *type;
+				ListenerKey key;
+
+				friend bool operator==(Id const &a, Id const &b) noexcept
+				{
+					return a.type == b.type && a.key == b.key;
+				}
+			};
+			struct Hash final
+			{
+				auto operator()(Id const &id) const noexcept
+				-> std::size_t
+				{
+					return std::hash<void const *>{}(id.type)*31 + std::hash<ListenerKey::Key_t>{}(id.key.value());
+				}
+			};
+			struct Pending
+			{
+				Id const id;
+				Pending(Id i) noexcept
+				: id(i)
+				{
+				}
+				virtual ~Pending() noexcept = default;
+				virtual void call() = 0;
+			};
+			template<typename EventT>
+			struct Held final
+			: Pending
+			{
+				EventT e;
+				template<typename T>
+				Held(Id id, T &&t)
+				: Pending{id}
+				, e{std::forward<T>(t)}
+				{
+				}
+				virtual void call() override
+				{
+					e.call();
+				}
+			};
+
+			Clock_t::duration const bound;
+			Clock_t::time_point oldest;
+			std::vector<std::unique_ptr<Pending>> pending;
+			std::unordered_map<Id, std::size_t, Hash> index; //into pending
+			std::size_t merged = 0;
+
+			void add(std::unique_ptr<Pending> p);
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef LB_events_Coroutine_HeaderPlusPlus
+#define LB_events_Coroutine_HeaderPlusPlus
+
+#include "Event.hpp"
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define LB_EVENTS_COROUTINES
+#endif
+#endif
+
+#ifdef LB_EVENTS_COROUTINES
+#include <coroutine>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace LB
+{
+	namespace events
+	{
+		namespace impl
+		{
+			struct Always final
+			{
+				template<typename EventT>
+				constexpr bool operator()(EventT const &) const noexcept
+				{
+					return true;
+				}
+			};
+		}
+
+		//The awaiter returned by next(). It is the Reactor itself and lives in the coroutine frame,
+		//so waiting allocates nothing beyond what listening always does. It only listens while
+		//the coroutine is suspended, and the matching react() resumes the coroutine directly.
+		template<typename EventT, typename PredicateT = impl::Always>
+		struct NextEvent final
+		: Reactor<EventT>
+		{
+			NextEvent(PredicateT p, ListenerKey k, ListenerPriority l) noexcept
+			: Reactor<EventT>(ListenLater{})
+			, predicate(std::move(p))
+			, key{k}
+			, priority{l}
+			{
+			}
+			virtual ~NextEvent() noexcept
+			{
+				//When the coroutine is destroyed without having been resumed
+				this->ignore();
+			}
+
+			bool await_ready() const noexcept
+			{
+				return false;
+			}
+			void await_suspend(std::coroutine_handle<> h) noexcept
+			{
+				waiting = h;
+				if(key)
+				{
+					this->listen(key, priority);
+				}
+				else
+				{
+					this->listen(priority);
+				}
+			}
+			//Only valid until the coroutine next suspends, since the caller owns the event
+			auto await_resume() const noexcept
+			-> EventT const &
+			{
+				return *event;
+			}
+
+		private:
+			PredicateT predicate;
+			ListenerKey const key;
+			ListenerPriority const priority;
+			std::coroutine_handle<> waiting;
+			EventT const *event = nullptr;
+
+			virtual void react(EventT const &e) noexcept(EventT::NOEXCEPT) override
+			{
+				if(!waiting || !predicate(e))
+				{
+					return;
+				}
+				//Stop listening first, since the coroutine is free to destroy this once resumed
+				this->ignore();
+				event = std::addressof(e);
+				std::exchange(waiting, nullptr).resume();
+			}
+		};
+
+		//co_await next<SomeEvent>() suspends the coroutine until the next SomeEvent reacts, then
+		//resumes it from inside that react phase, among the other reactors of its priority.
+		//With LB_EVENTS_CONCURRENT, the event must only be called from one thread while waiting.
+		template<typename EventT, typename PredicateT = impl::Always>
+		auto next(PredicateT &&p = PredicateT{}, ListenerPriority priority = ListenerPriority{}) noexcept
+		-> NextEvent<EventT, typename std::decay<PredicateT>::type>
+		{
+			return {std::forward<PredicateT>(p), ListenerKey{}, priority};
+		}
+		//Only for events whose key() is key
+		template<typename EventT, typename PredicateT = impl::Always>
+		auto next(ListenerKey key, PredicateT &&p = PredicateT{}, ListenerPriority priority = ListenerPriority{}) noexcept
+		-> NextEvent<EventT, typename std::decay<PredicateT>::type>
+		{
+			return {std::forward<PredicateT>(p), key, priority};
+		}
+	}
+}
+#endif
+
+#endif
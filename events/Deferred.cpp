@@ -0,0 +1,135 @@
+#include "Deferred.hpp"
+
+namespace LB
+{
+	namespace events
+	{
+		namespace
+		{
+			template<std::size_t N>
+			constexpr std::size_t round_up(std::size_t n) noexcept
+			{
+				return (n + N - 1)/N*N;
+			}
+		}
+
+		DeferredEvents::DeferredEvents(std::size_t c)
+		: capacity{round_up<UNIT>(c < 16*UNIT? 16*UNIT : c)}
+		, buffer{new unsigned char[capacity]}
+		{
+		}
+		DeferredEvents::~DeferredEvents() noexcept
+		{
+			while(used != 0)
+			{
+				auto &r = record(head);
+				if(r.call)
+				{
+					r.destroy(buffer.get() + head + UNIT);
+				}
+				head = (head + r.size) % capacity;
+				used -= r.size;
+			}
+		}
+
+		auto DeferredEvents::call()
+		-> std::size_t
+		{
+			std::size_t n = 0;
+			for(;;)
+			{
+				if(used != 0)
+				{
+					auto &r = record(head);
+					if(!r.call)
+					{
+						head = 0;
+						used -= r.size;
+						continue;
+					}
+					//Released only once the event is done, so that events it defers cannot reuse its space
+					struct Release final
+					{
+						DeferredEvents &d;
+						Record &r;
+						~Release() noexcept
+						{
+							r.destroy(d.buffer.get() + d.head + UNIT);
+							d.used -= r.size;
+							d.head = (d.head + r.size) % d.capacity;
+							if(d.used == 0)
+							{
+								//Starting over at the front saves wrapping later
+								d.head = d.tail = 0;
+							}
+						}
+					} const release {*this, r};
+					++n;
+					r.call(buffer.get() + head + UNIT);
+				}
+				else if(!overflow.empty())
+				{
+					auto const e = std::move(overflow.front());
+					overflow.pop_front();
+					++n;
+					e->call();
+				}
+				else
+				{
+					return n;
+				}
+			}
+		}
+
+		auto DeferredEvents::reserve(std::size_t n) noexcept
+		-> void *
+		{
+			reserved = UNIT + round_up<UNIT>(n);
+			padding = (tail + reserved > capacity)? capacity - tail : 0;
+			if(used + padding + reserved > capacity)
+			{
+				return nullptr;
+			}
+			return buffer.get() + (tail + padding) % capacity + UNIT;
+		}
+		void DeferredEvents::commit(Call_t call, Destroy_t destroy) noexcept
+		{
+			if(padding != 0)
+			{
+				record(tail) = Record{nullptr, nullptr, padding};
+				used += padding;
+				tail = 0;
+			}
+			record(tail) = Record{call, destroy, reserved};
+			used += reserved;
+			tail = (tail + reserved) % capacity;
+		}
+		void DeferredEvents::spill(std::unique_ptr<Event> e)
+		{
+			if(overflow.empty())
+			{
+				if(void *p = reserve(sizeof(Event *)))
+				{
+					::new(p) Event *(e.release());
+					commit(&Spilled::call, &Spilled::destroy);
+					return;
+				}
+			}
+			overflow.push_back(std::move(e));
+		}
+		auto DeferredEvents::record(std::size_t offset) const noexcept
+		-> Record &
+		{
+			return *reinterpret_cast<Record *>(buffer.get() + offset);
+		}
+
+		void DeferredEvents::Spilled::call(void *p)
+		{
+			(*static_cast<Event **>(p))->call();
+		}
+		void DeferredEvents::Spilled::destroy(void *p) noexcept
+		{
+			delete *static_cast<Event **>(p);
+		}
+	}
+}
@@ -0,0 +1,110 @@
+#ifndef LB_events_Deferred_HeaderPlusPlus
+#define LB_events_Deferred_HeaderPlusPlus
+
+#include "Event.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace LB
+{
+	namespace events
+	{
+		//Holds events of any type until call() is invoked, moved inline into a ring buffer so that
+		//deferring an event does not allocate. Events which are over-aligned or larger than an
+		//eighth of the buffer are allocated on their own, and so is everything deferred while the
+		//buffer is full, until it has drained. Like the Registrar, only usable from one thread
+		//at a time; see Pipeline for handing events to another thread.
+		struct DeferredEvents final
+		{
+			explicit DeferredEvents(std::size_t capacity = 64*1024);
+			DeferredEvents(DeferredEvents const &) = delete;
+			DeferredEvents &operator=(DeferredEvents const &) = delete;
+			DeferredEvents(DeferredEvents &&) = delete;
+			DeferredEvents &operator=(DeferredEvents &&) = delete;
+			//Destroys the events which were never called
+			~DeferredEvents() noexcept;
+
+			template<typename EventT>
+			void defer(EventT &&e)
+			{
+				using Event_t = typename std::decay<EventT>::type;
+				static_assert(std::is_base_of<Event, Event_t>::value, "EventT must derive from Event");
+				if(overflow.empty() && sizeof(Event_t) <= capacity/8 && alignof(Event_t) <= UNIT)
+				{
+					if(void *p = reserve(sizeof(Event_t)))
+					{
+						::new(p) Event_t(std::forward<EventT>(e));
+						commit(&Inline<Event_t>::call, &Inline<Event_t>::destroy);
+						return;
+					}
+				}
+				spill(std::unique_ptr<Event>{new Event_t(std::forward<EventT>(e))});
+			}
+
+			//Calls and destroys the deferred events in the order they were deferred, including any
+			//deferred meanwhile, and returns how many were called. If an event throws, it is
+			//destroyed and the rest stay deferred.
+			auto call()
+			-> std::size_t;
+
+			bool empty() const noexcept
+			{
+				return used == 0 && overflow.empty();
+			}
+
+		private:
+			using Call_t = void (*)(void *);
+			using Destroy_t = void (*)(void *) noexcept;
+			struct Record final
+			{
+				Call_t call; //null for the padding in front of a wrap
+				Destroy_t destroy;
+				std::size_t size;
+			};
+			//Every record and its event start on a multiple of this
+			static constexpr std::size_t UNIT = (sizeof(Record) + alignof(std::max_align_t) - 1)/alignof(std::max_align_t)*alignof(std::max_align_t);
+
+			template<typename EventT>
+			struct Inline final
+			{
+				static void call(void *p)
+				{
+					static_cast<EventT *>(p)->call();
+				}
+				static void destroy(void *p) noexcept
+				{
+					static_cast<EventT *>(p)->~EventT();
+				}
+			};
+			struct Spilled final
+			{
+				static void call(void *p);
+				static void destroy(void *p) noexcept;
+			};
+
+			std::size_t const capacity;
+			std::unique_ptr<unsigned char[]> buffer;
+			std::size_t head = 0; //offsets into buffer
+			std::size_t tail = 0;
+			std::size_t used = 0;
+			std::size_t reserved = 0; //size of the record being deferred
+			std::size_t padding = 0; //to be skipped at the end of the buffer first
+			std::deque<std::unique_ptr<Event>> overflow;
+
+			//Returns where an event of n bytes can be constructed, or null if there is no room
+			auto reserve(std::size_t n) noexcept
+			-> void *;
+			void commit(Call_t call, Destroy_t destroy) noexcept;
+			void spill(std::unique_ptr<Event> e);
+			auto record(std::size_t offset) const noexcept
+			-> Record &;
+		};
+	}
+}
+
+#endif
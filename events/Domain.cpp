@@ -0,0 +1,42 @@
+#include "Domain.hpp"
+
+namespace LB
+{
+	namespace events
+	{
+		EventDomain::EventDomain(std::size_t capacity)
+		: inbox{new DeferredEvents{capacity}}
+		, outbox{new DeferredEvents{capacity}}
+		{
+		}
+		//The events are destroyed before the registrars, which are a base
+		EventDomain::~EventDomain() noexcept = default;
+
+		auto EventDomain::drain()
+		-> std::size_t
+		{
+			if(draining || (!forwarded.load(std::memory_order_acquire) && outbox->empty()))
+			{
+				return 0;
+			}
+			draining = true;
+			struct Draining final
+			{
+				bool &draining;
+				~Draining() noexcept
+				{
+					draining = false;
+				}
+			} const guard {draining};
+			Scope const scope {*this};
+			//Whatever a throwing event left behind goes before anything forwarded since
+			auto n = outbox->call();
+			{
+				std::lock_guard<std::mutex> const lock {m};
+				std::swap(inbox, outbox);
+				forwarded.store(false, std::memory_order_relaxed);
+			}
+			return n + outbox->call();
+		}
+	}
+}
@@ -0,0 +1,95 @@
+#ifndef LB_events_Domain_HeaderPlusPlus
+#define LB_events_Domain_HeaderPlusPlus
+
+#include "Deferred.hpp"
+#include "Event.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace LB
+{
+	namespace events
+	{
+		//Owns its own Registrar for every event type, so that listening to and calling events
+		//within a Scope never touches the listeners of another domain or the process-wide ones.
+		//Give each thread (or shard) its own domain and forward() the events that must cross.
+		//Every listener must stop listening before the domain it listens to is destroyed.
+		struct EventDomain final
+		: private impl::Registrars
+		{
+			//capacity is that of the inline buffer forwarded events wait in, see DeferredEvents
+			explicit EventDomain(std::size_t capacity = 64*1024);
+			EventDomain(EventDomain const &) = delete;
+			EventDomain &operator=(EventDomain const &) = delete;
+			EventDomain(EventDomain &&) = delete;
+			EventDomain &operator=(EventDomain &&) = delete;
+			//Destroys the forwarded events which were never drained
+			~EventDomain() noexcept;
+
+			//Until destroyed, every event listened to or called on this thread uses the registrars
+			//of the given domain, or the process-wide ones for nullptr. Scopes nest.
+			struct Scope final
+			{
+				explicit Scope(EventDomain &d) noexcept
+				: current{&d}
+				{
+				}
+				explicit Scope(EventDomain *d) noexcept
+				: current{d}
+				{
+				}
+				explicit Scope(std::nullptr_t) noexcept
+				: current{nullptr}
+				{
+				}
+				Scope(Scope const &) = delete;
+				Scope &operator=(Scope const &) = delete;
+				Scope(Scope &&) = delete;
+				Scope &operator=(Scope &&) = delete;
+				~Scope() noexcept = default;
+
+			private:
+				impl::CurrentRegistrars const current;
+			};
+
+			//The domain of the innermost Scope on this thread, or null for the process-wide one
+			static auto current() noexcept
+			-> EventDomain *
+			{
+				return static_cast<EventDomain *>(impl::current_registrars());
+			}
+
+			//Moves e into this domain to be called by the next drain(). Callable from any thread;
+			//it costs one uncontended lock and, while the buffer has room, no allocation.
+			template<typename EventT>
+			void forward(EventT &&e)
+			{
+				static_assert(std::is_base_of<Event, typename std::decay<EventT>::type>::value, "EventT must derive from Event");
+				std::lock_guard<std::mutex> const lock {m};
+				inbox->defer(std::forward<EventT>(e));
+				forwarded.store(true, std::memory_order_release);
+			}
+
+			//Calls the forwarded events in the order they were forwarded, within a Scope of this
+			//domain, and returns how many were called. Only the thread which owns this domain
+			//should drain it; events forwarded meanwhile wait for the next drain(). Does nothing
+			//when called from within a drain(). If an event throws, the rest stay forwarded.
+			auto drain()
+			-> std::size_t;
+
+		private:
+			std::mutex m;
+			std::unique_ptr<DeferredEvents> inbox; //guarded by m
+			std::unique_ptr<DeferredEvents> outbox; //only touched by drain()
+			std::atomic<bool> forwarded {false};
+			bool draining = false;
+		};
+	}
+}
+
+#endif
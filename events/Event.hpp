@@ -14,6 +14,7 @@ namespace LB
 
 			virtual void call() noexcept(NOEXCEPT) final
 			{
+				impl::Span const span {impl::Span::CALL, this};
 				process();
 				react();
 			}
@@ -26,6 +27,47 @@ namespace LB
 			{
 				return true;
 			}
+
+			//Listeners which listen with a key are only called for events with the same key
+			virtual auto key() const noexcept
+			-> ListenerKey
+			{
+				return {};
+			}
+
+			//Checked once by react() before any reactor is called; false skips the reacting phase
+			virtual bool reactable() const noexcept
+			{
+				return true;
+			}
+
+			//Whether should_react() singles out particular reactors rather than judging by the event
+			//alone. If so, static and delegate reactors, which have no listener object to offer
+			//it, do not react.
+			virtual bool chooses_reactors() const noexcept
+			{
+				return false;
+			}
+
+			//When set, react() calls only this reactor, and only if it is still listening
+			virtual auto direct_reactor() const noexcept
+			-> DirectReactor
+			{
+				return {};
+			}
+
+			//For a processor which made a final decision: no further processor is called
+			void stop_processing() noexcept
+			{
+				stopped = true;
+			}
+			bool processing_stopped() const noexcept
+			{
+				return stopped;
+			}
+
+		private:
+			bool stopped = false;
 		};
 		inline Event::~Event() = default;
 	}
@@ -3,18 +3,42 @@
 
 #include "LB/tuples/tuples.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <type_traits>
 #include <functional>
 #include <memory>
-#include <map>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <optional>
+#include <chrono>
+#include <iterator>
+#include <array>
+#ifdef LB_EVENTS_CONCURRENT
+#include <thread>
+#endif
+#ifdef LB_EVENTS_TRACING
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define LB_EVENTS_IMPL_TSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define LB_EVENTS_IMPL_TSC
+#endif
+#endif
 
 namespace LB
 {
 	namespace events
 	{
 		struct Event;
+		template<typename EventT>
+		struct Registrar;
 
 		struct ListenerPriority final
 		{
@@ -54,6 +78,210 @@ namespace LB
 			Priority_t const priority;
 		};
 
+		struct ListenerHandle final
+		{
+			using Slot_t = std::size_t;
+			using Generation_t = std::size_t;
+
+			static constexpr Slot_t NONE = std::numeric_limits<Slot_t>::max();
+
+			constexpr ListenerHandle() noexcept
+			: slot{NONE}
+			, gen{}
+			{
+			}
+			constexpr ListenerHandle(Slot_t s, Generation_t g) noexcept
+			: slot{s}
+			, gen{g}
+			{
+			}
+
+			constexpr explicit operator bool() const noexcept
+			{
+				return slot != NONE;
+			}
+			constexpr Slot_t index() const noexcept
+			{
+				return slot;
+			}
+			//Tells apart the listeners which have used the same slot one after another
+			constexpr Generation_t generation() const noexcept
+			{
+				return gen;
+			}
+
+		private:
+			Slot_t slot;
+			Generation_t gen;
+		};
+
+		//Restricts a listener to the events whose key() is the same, such as the instance that a
+		//Construct<T> event is for. A default constructed key listens to every event.
+		struct ListenerKey final
+		{
+			using Key_t = std::uintptr_t;
+
+			constexpr ListenerKey() noexcept
+			: key{}
+			, keyed{false}
+			{
+			}
+			explicit ListenerKey(void const *instance) noexcept
+			: key{reinterpret_cast<Key_t>(instance)}
+			, keyed{true}
+			{
+			}
+			template<typename T, typename = typename std::enable_if<std::is_integral<T>::value>::type>
+			constexpr explicit ListenerKey(T topic) noexcept
+			: key{static_cast<Key_t>(topic)}
+			, keyed{true}
+			{
+			}
+
+			constexpr explicit operator bool() const noexcept
+			{
+				return keyed;
+			}
+			constexpr Key_t value() const noexcept
+			{
+				return key;
+			}
+
+			friend constexpr bool operator==(ListenerKey const &a, ListenerKey const &b) noexcept
+			{
+				return a.keyed == b.keyed && a.key == b.key;
+			}
+			friend constexpr bool operator!=(ListenerKey const &a, ListenerKey const &b) noexcept
+			{
+				return !(a == b);
+			}
+
+		private:
+			Key_t key;
+			bool keyed;
+		};
+
+		//Constructs a Processor/Reactor without listening yet, for classes that must finish
+		//constructing before they can be called (always the case with LB_EVENTS_CONCURRENT)
+		struct ListenLater final
+		{
+		};
+
+		//Runs the reactors which opted in to parallel() when several of them are next to each
+		//other with the same priority. See Parallel.hpp for a work-stealing implementation.
+		struct ParallelExecutor
+		{
+			using Task_t = void (*)(void *context, std::size_t i);
+
+			virtual ~ParallelExecutor() = 0;
+
+			//Calls task(context, i) for every i in [0, n) and returns once all of them have finished
+			virtual void run(std::size_t n, Task_t task, void *context) = 0;
+		};
+		inline ParallelExecutor::~ParallelExecutor() = default;
+		namespace impl
+		{
+			//The Registrar of every event type used within one EventDomain, created on first use
+			struct Registrars
+			{
+				Registrars() = default;
+				Registrars(Registrars const &) = delete;
+				Registrars &operator=(Registrars const &) = delete;
+				Registrars(Registrars &&) = delete;
+				Registrars &operator=(Registrars &&) = delete;
+				~Registrars() noexcept
+				{
+					for(auto it = registrars.rbegin(); it != registrars.rend(); ++it)
+					{
+						if(it->registrar)
+						{
+							it->destroy(it->registrar);
+						}
+					}
+				}
+
+				//index is unique per event type, see next_type_index()
+				template<typename RegistrarT, typename MakeT>
+				auto get(std::size_t index, MakeT make)
+				-> RegistrarT &
+				{
+					if(index >= registrars.size())
+					{
+						registrars.resize(index + 1);
+					}
+					auto &entry = registrars[index];
+					if(!entry.registrar)
+					{
+						entry.registrar = make();
+						entry.destroy = [](void *r) noexcept
+						{
+							delete static_cast<RegistrarT *>(r);
+						};
+					}
+					return *static_cast<RegistrarT *>(entry.registrar);
+				}
+
+			private:
+				struct Entry final
+				{
+					void *registrar = nullptr;
+					void (*destroy)(void *) noexcept = nullptr;
+				};
+				std::vector<Entry> registrars;
+			};
+			//The Registrars which LB_EVENTS_EVENT resolves to on this thread, or null for the
+			//process-wide ones
+			inline auto current_registrars() noexcept
+			-> Registrars *&
+			{
+				thread_local Registrars *current = nullptr;
+				return current;
+			}
+			//Makes registrars current on the calling thread until destroyed, see EventDomain::Scope
+			struct CurrentRegistrars final
+			{
+				explicit CurrentRegistrars(Registrars *registrars) noexcept
+				: previous{current_registrars()}
+				{
+					current_registrars() = registrars;
+				}
+				CurrentRegistrars(CurrentRegistrars const &) = delete;
+				CurrentRegistrars &operator=(CurrentRegistrars const &) = delete;
+				CurrentRegistrars(CurrentRegistrars &&) = delete;
+				CurrentRegistrars &operator=(CurrentRegistrars &&) = delete;
+				~CurrentRegistrars() noexcept
+				{
+					current_registrars() = previous;
+				}
+
+			private:
+				Registrars *const previous;
+			};
+			inline auto next_type_index() noexcept
+			-> std::size_t
+			{
+				static std::atomic<std::size_t> next {0};
+				return next.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			inline auto parallel_executor() noexcept
+			-> std::atomic<ParallelExecutor *> &
+			{
+				static std::atomic<ParallelExecutor *> executor {nullptr};
+				return executor;
+			}
+		}
+		//Without an executor, parallel reactors are run one after another like any other
+		inline void parallel_executor(ParallelExecutor *executor) noexcept
+		{
+			impl::parallel_executor().store(executor);
+		}
+		inline auto parallel_executor() noexcept
+		-> ParallelExecutor *
+		{
+			return impl::parallel_executor().load(std::memory_order_acquire);
+		}
+
 		struct ProcessorBase
 		{
 			virtual ~ProcessorBase() = 0;
@@ -69,6 +297,9 @@ namespace LB
 			{
 				listen(priority);
 			}
+			Processor(ListenLater) noexcept
+			{
+			}
 			Processor(Processor const &) = delete;
 			Processor &operator=(Processor const &) = delete;
 			Processor(Processor &&) = delete;
@@ -79,34 +310,48 @@ namespace LB
 			}
 
 		protected:
-			void listen(ListenerPriority priority = ListenerPriority{}) noexcept
+			auto listen(ListenerPriority priority = ListenerPriority{}) noexcept
+			-> ListenerHandle
 			{
 				return Event_t::listen(*this, priority);
 			}
+			auto listen(ListenerKey key, ListenerPriority priority = ListenerPriority{}) noexcept
+			-> ListenerHandle
+			{
+				return Event_t::listen(*this, key, priority);
+			}
 			void ignore() noexcept
 			{
 				return Event_t::ignore(*this);
 			}
 
 		private:
+			mutable ListenerHandle handle; //owned by the Registrar
+			mutable ListenerKey key; //owned by the Registrar
+			mutable Registrar<EventT> *owner = nullptr; //the Registrar this is listening to
 			virtual void process(Event_t &e) const noexcept(EventT::NOEXCEPT) = 0;
 
 			friend typename Event_t::Registrar_t;
 		};
 
-		template<typename EventT>
+		//LambdaT is stored inline, so any callable type other than the default std::function
+		//never allocates and its call can be inlined into process()
+		template<typename EventT, typename LambdaT = std::function<void (EventT &e) /*const*/>>
 		struct LambdaProcessor final
 		: Processor<EventT>
 		{
-			using Lambda_t = std::function<void (EventT &e) /*const*/>;
+			using Lambda_t = LambdaT;
 			LambdaProcessor(Lambda_t l, ListenerPriority priority = ListenerPriority{}) noexcept
-			: Processor<EventT>(priority)
-			, lambda{l}
+			: Processor<EventT>(ListenLater{})
+			, lambda{std::move(l)}
 			{
+				this->listen(priority);
 			}
 			LambdaProcessor(LambdaProcessor const &from) noexcept
-			: lambda{from.lambda}
+			: Processor<EventT>(ListenLater{})
+			, lambda{from.lambda}
 			{
+				this->listen();
 			}
 			LambdaProcessor &operator=(LambdaProcessor const &from) noexcept
 			{
@@ -114,14 +359,21 @@ namespace LB
 				return *this;
 			}
 			LambdaProcessor(LambdaProcessor &&from) noexcept
-			: lambda{std::move(from.lambda)}
+			: Processor<EventT>(ListenLater{})
+			, lambda{std::move(from.lambda)}
 			{
+				this->listen();
 			}
 			LambdaProcessor &operator=(LambdaProcessor &&from) noexcept
 			{
 				lambda = std::move(from.lambda);
 				return *this;
 			}
+			virtual ~LambdaProcessor() noexcept
+			{
+				//Stop listening before the lambda is destroyed
+				this->ignore();
+			}
 
 		private:
 			Lambda_t lambda;
@@ -130,6 +382,162 @@ namespace LB
 				return lambda(e);
 			}
 		};
+		template<typename EventT, typename LambdaT>
+		auto lambda_processor(LambdaT &&l, ListenerPriority priority = ListenerPriority{}) noexcept
+		-> LambdaProcessor<EventT, typename std::decay<LambdaT>::type>
+		{
+			return {std::forward<LambdaT>(l), priority};
+		}
+
+		namespace impl
+		{
+			struct Sampler;
+		}
+		//Which of the events a reactor would react to it actually reacts to, for loggers,
+		//auditors and profilers on hot events which only need a statistical sample. The Registrar
+		//applies it after should_react() and before react(), so an event which is left out costs
+		//a counter check (or a clock read, for rate()) instead of a virtual call.
+		struct Sampling final
+		{
+			//Every event
+			constexpr Sampling() noexcept = default;
+
+			//The first of every n events
+			static constexpr auto every(std::uint64_t n) noexcept
+			-> Sampling
+			{
+				return n > 1? Sampling{EVERY, n, 0} : Sampling{};
+			}
+			//Each event independently with probability p
+			static constexpr auto probability(double p) noexcept
+			-> Sampling
+			{
+				return p >= 1? Sampling{} : Sampling{RANDOM, p > 0? static_cast<std::uint64_t>(p*ONE) : 0, 0};
+			}
+			//At most per_second events per second on average and at most burst at once, as a
+			//token bucket which starts full. Periods past LONGEST are cut down to it.
+			static constexpr auto rate(double per_second, double burst = 1) noexcept
+			-> Sampling
+			{
+				if(!(per_second > 0))
+				{
+					return probability(0);
+				}
+				auto const interval = 1e9/per_second;
+				return {RATE, nanoseconds(interval), burst > 1? nanoseconds((burst - 1)*interval) : 0};
+			}
+			//2^62 nanoseconds, about 146 years, so that the clock plus both periods of a rate()
+			//always fits in 64 bits
+			static constexpr double LONGEST = 4611686018427387904.0;
+
+		private:
+			enum Kind : std::uint8_t
+			{
+				ALL,
+				EVERY,
+				RANDOM,
+				RATE
+			};
+			static constexpr double ONE = 9007199254740992.0; //2^53, the resolution of a probability
+			Kind kind = ALL;
+			std::uint64_t a = 0; //every n, probability*ONE, or nanoseconds per event
+			std::uint64_t b = 0; //nanoseconds a burst may run ahead of the rate
+
+			constexpr Sampling(Kind k, std::uint64_t a, std::uint64_t b) noexcept
+			: kind{k}
+			, a{a}
+			, b{b}
+			{
+			}
+			//Converting a double which does not fit in the integer is undefined
+			static constexpr auto nanoseconds(double ns) noexcept
+			-> std::uint64_t
+			{
+				return ns < LONGEST? static_cast<std::uint64_t>(ns) : static_cast<std::uint64_t>(LONGEST);
+			}
+			friend struct impl::Sampler;
+		};
+		namespace impl
+		{
+			//The Sampling of one reactor and its state, which concurrent calls may share
+			struct Sampler final
+			{
+				Sampler() = default;
+				Sampler(Sampler const &) = delete;
+				Sampler &operator=(Sampler const &) = delete;
+				Sampler(Sampler &&) = delete;
+				Sampler &operator=(Sampler &&) = delete;
+
+				void reset(Sampling s) noexcept
+				{
+					policy = s;
+					state.store(0, std::memory_order_relaxed);
+				}
+				//Whether the next event is part of the sample
+				bool take() noexcept
+				{
+					switch(policy.kind)
+					{
+						case Sampling::ALL:
+						{
+							return true;
+						}
+						case Sampling::EVERY:
+						{
+							//Counts down the events left to skip. Threads calling at once may lose
+							//each other's updates, which only makes the sample a little larger; an
+							//atomic decrement would cost more than the react() it saves.
+							auto const left = state.load(std::memory_order_relaxed);
+							state.store(left? left - 1 : policy.a - 1, std::memory_order_relaxed);
+							return left == 0;
+						}
+						case Sampling::RANDOM:
+						{
+							return (random() >> 11) < policy.a;
+						}
+						case Sampling::RATE:
+						{
+							//The generic cell rate algorithm: state is when the bucket will next be
+							//full, so one atomic word is the whole bucket
+							auto const now = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+							auto full = state.load(std::memory_order_relaxed);
+							for(;;)
+							{
+								auto const from = full > now? full : now;
+								if(from - now > policy.b)
+								{
+									return false;
+								}
+								if(state.compare_exchange_weak(full, from + policy.a, std::memory_order_relaxed))
+								{
+									return true;
+								}
+							}
+						}
+					}
+					return true;
+				}
+
+			private:
+				Sampling policy;
+				std::atomic<std::uint64_t> state {0};
+
+				//xorshift64* per thread, so that sampling never writes to memory another thread reads
+				static auto random() noexcept
+				-> std::uint64_t
+				{
+					thread_local std::uint64_t x = 0; //constant initialized, so no guard on every call
+					if(x == 0)
+					{
+						x = (reinterpret_cast<std::uintptr_t>(&x) ^ static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count())) | 1;
+					}
+					x ^= x >> 12;
+					x ^= x << 25;
+					x ^= x >> 27;
+					return x*0x2545F4914F6CDD1Dull;
+				}
+			};
+		}
 
 		struct ReactorBase
 		{
@@ -146,6 +554,9 @@ namespace LB
 			{
 				listen(priority);
 			}
+			Reactor(ListenLater) noexcept
+			{
+			}
 			Reactor(Reactor const &) = delete;
 			Reactor &operator=(Reactor const &) = delete;
 			Reactor(Reactor &&) = delete;
@@ -156,34 +567,77 @@ namespace LB
 			}
 
 		protected:
-			void listen(ListenerPriority priority = ListenerPriority{}) noexcept
+			auto listen(ListenerPriority priority = ListenerPriority{}) noexcept
+			-> ListenerHandle
 			{
 				return Event_t::listen(*this, priority);
 			}
+			auto listen(ListenerKey key, ListenerPriority priority = ListenerPriority{}) noexcept
+			-> ListenerHandle
+			{
+				return Event_t::listen(*this, key, priority);
+			}
 			void ignore() noexcept
 			{
 				return Event_t::ignore(*this);
 			}
+			//Listens, reacting only to the events which sampling picks
+			auto listen(Sampling sampling, ListenerPriority priority = ListenerPriority{}) noexcept
+			-> ListenerHandle
+			{
+				sample(sampling);
+				return listen(priority);
+			}
+			//Allows this reactor to run at the same time as other parallel reactors of the same
+			//priority, for reactors which only touch state that no such reactor also touches.
+			//Set it before listening if other threads may be calling the event.
+			void parallel(bool p) noexcept
+			{
+				parallel_safe = p;
+			}
+			//Reacts only to the events which s picks from now on, starting over. Set it before
+			//listening if other threads may be calling the event.
+			void sample(Sampling s) noexcept
+			{
+				sampler.reset(s);
+			}
 
 		private:
+			ListenerHandle handle; //owned by the Registrar
+			ListenerKey key; //owned by the Registrar
+			Registrar<EventT> *owner = nullptr; //the Registrar this is listening to
+			bool parallel_safe = false;
+			impl::Sampler sampler;
 			virtual void react(Event_t const &e) noexcept(EventT::NOEXCEPT) = 0;
 
 			friend typename Event_t::Registrar_t;
+			friend struct DirectReactor;
 		};
 
-		template<typename EventT>
+		//LambdaT is stored inline, so any callable type other than the default std::function
+		//never allocates and its call can be inlined into react()
+		template<typename EventT, typename LambdaT = std::function<void (EventT const &e)>>
 		struct LambdaReactor
 		: Reactor<EventT>
 		{
-			using Lambda_t = std::function<void (EventT const &e)>;
+			using Lambda_t = LambdaT;
 			LambdaReactor(Lambda_t l, ListenerPriority priority = ListenerPriority{}) noexcept
-			: Reactor<EventT>(priority)
-			, lambda{l}
+			: Reactor<EventT>(ListenLater{})
+			, lambda{std::move(l)}
+			{
+				this->listen(priority);
+			}
+			LambdaReactor(Lambda_t l, Sampling sampling, ListenerPriority priority = ListenerPriority{}) noexcept
+			: Reactor<EventT>(ListenLater{})
+			, lambda{std::move(l)}
 			{
+				this->listen(sampling, priority);
 			}
 			LambdaReactor(LambdaReactor const &from) noexcept
-			: lambda{from.lambda}
+			: Reactor<EventT>(ListenLater{})
+			, lambda{from.lambda}
 			{
+				this->listen();
 			}
 			LambdaReactor &operator=(LambdaReactor const &from) noexcept
 			{
@@ -191,14 +645,21 @@ namespace LB
 				return *this;
 			}
 			LambdaReactor(LambdaReactor &&from) noexcept
-			: lambda{std::move(from.lambda)}
+			: Reactor<EventT>(ListenLater{})
+			, lambda{std::move(from.lambda)}
 			{
+				this->listen();
 			}
 			LambdaReactor &operator=(LambdaReactor &&from) noexcept
 			{
 				lambda = std::move(from.lambda);
 				return *this;
 			}
+			virtual ~LambdaReactor() noexcept
+			{
+				//Stop listening before the lambda is destroyed
+				this->ignore();
+			}
 
 		private:
 			Lambda_t lambda;
@@ -207,142 +668,2658 @@ namespace LB
 				return lambda(e);
 			}
 		};
-
-		template<typename EventT>
-		struct Registrar final
+		template<typename EventT, typename LambdaT>
+		auto lambda_reactor(LambdaT &&l, ListenerPriority priority = ListenerPriority{}) noexcept
+		-> LambdaReactor<EventT, typename std::decay<LambdaT>::type>
 		{
-			static_assert(std::is_base_of<Event, EventT>::value, "EventT must derive from Event");
-			using Event_t = EventT;
-			using Processor_t = Processor<EventT>;
-			using Reactor_t = Reactor<EventT>;
+			return {std::forward<LambdaT>(l), priority};
+		}
+		namespace impl
+		{
+			//Only its address is used, to tell event types apart without RTTI
+			template<typename EventT>
+			struct Level final
+			{
+				static char const tag;
+			};
+			template<typename EventT>
+			char const Level<EventT>::tag = 0;
+		}
+		//A reactor which an event has chosen to be the only one to react to it, see Exclusive.
+		//Calling the event goes straight to it instead of visiting every other reactor. It is
+		//remembered by where it listened rather than trusted to still exist, so that it is only
+		//called if the Registrar still has it under the same handle.
+		struct DirectReactor final
+		{
+			constexpr DirectReactor() noexcept
+			: reactor{}
+			, level{}
+			, owner{}
+			, handle{}
+			, key{}
+			{
+			}
+			template<typename EventT>
+			DirectReactor(Reactor<EventT> &r) noexcept
+			: reactor{std::addressof(r)}
+			, level{&impl::Level<EventT>::tag}
+			, owner{r.owner}
+			, handle{r.handle}
+			, key{r.key}
+			{
+			}
 
-			static void listen(Processor_t const &p, ListenerPriority priority = ListenerPriority{}) noexcept
+			constexpr explicit operator bool() const noexcept
 			{
-				ignore(p);
-				processors().emplace(priority, std::cref(p));
+				return reactor != nullptr;
 			}
-			static void listen(Reactor_t &r, ListenerPriority priority = ListenerPriority{}) noexcept
+			//Whether the reactor reacts to EventT
+			template<typename EventT>
+			bool is() const noexcept
 			{
-				ignore(r);
-				reactors().emplace(priority, std::ref(r));
+				return level == &impl::Level<EventT>::tag;
 			}
 
-			static void ignore(Processor_t const &p) noexcept
+		private:
+			void *reactor; //only compared, never called through
+			void const *level;
+			void const *owner; //the Registrar it listened to
+			ListenerHandle handle;
+			ListenerKey key;
+
+			template<typename EventT>
+			friend struct Registrar;
+		};
+		//Processors and reactors which are functions known at compile time. They are listed in
+		//a specialization of StaticListeners for their event type instead of listening, so they
+		//cost nothing to register and are called directly, where they can be inlined. They run
+		//ahead of dynamic listeners of the same priority and are not offered to should_process()
+		//or should_react(), which take a listener object. F is a pointer to a function taking
+		//EventT & for processors and EventT const & for reactors.
+		template<typename EventT, auto F, ListenerPriority::Priority_t P = 0>
+		struct StaticProcessor final
+		{
+			using Event_t = EventT;
+			static constexpr bool PROCESSOR = true;
+			static constexpr ListenerPriority::Priority_t priority = P;
+			static void call(EventT &e) noexcept(EventT::NOEXCEPT)
 			{
-				auto &procs = processors();
-				for(auto it = procs.begin(); it != procs.end(); )
-				{
-					if(std::addressof(p) == std::addressof(it->second.get()))
-					{
-						it = procs.erase(it);
-					}
-					else ++it;
-				}
+				F(e);
 			}
-			static void ignore(Reactor_t &r) noexcept
+		};
+		template<typename EventT, auto F, ListenerPriority::Priority_t P = 0>
+		struct StaticReactor final
+		{
+			using Event_t = EventT;
+			static constexpr bool PROCESSOR = false;
+			static constexpr ListenerPriority::Priority_t priority = P;
+			static void call(EventT const &e) noexcept(EventT::NOEXCEPT)
 			{
-				auto &reacts = reactors();
-				for(auto it = reacts.begin(); it != reacts.end(); )
-				{
-					if(std::addressof(r) == std::addressof(it->second.get()))
-					{
-						it = reacts.erase(it);
-					}
-					else ++it;
-				}
+				F(e);
 			}
+		};
+		//The static listeners of one event type, in priority order
+		template<typename... ListenerT>
+		struct StaticList
+		{
+			using Priority_t = ListenerPriority::Priority_t;
 
-			static void process(Event_t &e) noexcept(EventT::NOEXCEPT)
+			static constexpr std::size_t PROCESSORS = (std::size_t{0} + ... + (ListenerT::PROCESSOR? 1 : 0));
+			static constexpr std::size_t REACTORS = sizeof...(ListenerT) - PROCESSORS;
+			static constexpr std::size_t LISTENERS = sizeof...(ListenerT); //a next which visits none
+
+			//Calls f(listener) for the processors or reactors from index next on whose priority is at
+			//most until, in order, and moves next past each one. f returns false, without calling
+			//the listener, to stop.
+			template<bool PROCESSOR, typename F>
+			static void visit(std::size_t &next, Priority_t until, F &&f)
 			{
-				for(p : processors())
-				{
-					if(e.should_process(p.second.get()))
-					{
-						p.second.get().process(e);
-					}
-				}
+				bool go = true;
+				visit<PROCESSOR>(next, until, f, go, std::index_sequence_for<ListenerT...>{});
 			}
-			static void react(Event_t const &e) noexcept(EventT::NOEXCEPT)
+
+		private:
+			static constexpr bool sorted() noexcept
 			{
-				for(r : reactors())
+				Priority_t const p[] {ListenerT::priority..., ListenerPriority::LAST};
+				for(std::size_t i = 0; i < sizeof...(ListenerT); ++i)
 				{
-					if(e.should_react(r.second.get()))
+					if(p[i] > p[i + 1])
 					{
-						r.second.get().react(e);
+						return false;
 					}
 				}
+				return true;
 			}
+			static_assert(sorted(), "Static listeners must be listed in priority order");
 
-		private:
-			friend typename Event_t::Implementor_t;
-			Registrar() = default;
-
-			using Processors_t = std::multimap<ListenerPriority, std::reference_wrapper<Processor_t const>>;
-			using Reactors_t = std::multimap<ListenerPriority, std::reference_wrapper<Reactor_t>>;
-			Processors_t ps;
-			Reactors_t rs;
-			static auto processors() noexcept
-			-> Processors_t &
+			template<bool PROCESSOR, typename F, std::size_t... I>
+			static void visit(std::size_t &next, Priority_t until, F &f, bool &go, std::index_sequence<I...>)
 			{
-				return Event_t::registrar().ps;
+				//Nothing is used when there are no static listeners
+				static_cast<void>(next), static_cast<void>(until), static_cast<void>(f), static_cast<void>(go);
+				(step<PROCESSOR, I, ListenerT>(next, until, f, go), ...);
 			}
-			static auto reactors() noexcept
-			-> Reactors_t &
+			template<bool PROCESSOR, std::size_t I, typename L, typename F>
+			static void step(std::size_t &next, Priority_t until, F &f, bool &go)
 			{
-				return Event_t::registrar().rs;
+				if constexpr(L::PROCESSOR == PROCESSOR)
+				{
+					if(!go || I < next)
+					{
+						return;
+					}
+					if(L::priority > until)
+					{
+						go = false;
+						return;
+					}
+					auto const previous = next;
+					next = I + 1;
+					if(!f(L{}))
+					{
+						next = previous;
+						go = false;
+					}
+				}
 			}
 		};
+		//Specialize for an event type, right after defining it and before anything calls it:
+		//template<> struct LB::events::StaticListeners<MyEvent> : LB::events::StaticList<...> {};
+		template<typename EventT>
+		struct StaticListeners
+		: StaticList<>
+		{
+		};
 
 		namespace impl
 		{
-			template<typename T, typename...>
-			struct Unwrapper;
-			template<typename T, typename First, typename... Rest>
-			struct Unwrapper<T, First, Rest...> final
+			template<typename FunctionT>
+			struct Delegate final
 			{
-				static_assert(std::is_base_of<Event, First>::value, "ParentT must derive from Event");
-				using Next = Unwrapper<T, Rest...>;
-				Unwrapper() = delete;
-				static void process(T &t) noexcept(T::NOEXCEPT)
-				{
-					First::Registrar_t::process(t);
-					Next::process(t);
-				}
-				static void react(T const &t) noexcept(T::NOEXCEPT)
-				{
-					First::Registrar_t::react(t);
-					Next::react(t);
-				}
-				static auto parents(T &t) noexcept
+				FunctionT function; //nullptr once ignored
+				void *context;
+
+				constexpr explicit operator bool() const noexcept
 				{
-					return tuple_cat(tuples::tuple<First &>{t}, Next::parents(t));
+					return function != nullptr;
 				}
-				static auto parents(T const &t) noexcept
+				Delegate &operator=(std::nullptr_t) noexcept
 				{
-					return tuple_cat(tuples::tuple<First const &>{t}, Next::parents(t));
+					function = nullptr;
+					context = nullptr;
+					return *this;
 				}
-				using all_parents_t = typename tuples::tuple_type_cat
-				<
-					typename First::Unwrapper_t::all_parents_t,
-					typename Rest::Unwrapper_t::all_parents_t...,
-					tuples::tuple<First>,
-					typename Next::all_parents_t
-				>::type;
 			};
-			template<typename T>
-			struct Unwrapper<T> final
+		}
+		//Listeners which are only a function pointer and a context pointer, with no virtual
+		//functions or virtual bases, for when there are very many small listeners. Without
+		//LB_EVENTS_CONCURRENT both pointers are copied into the Registrar's table, so calling one
+		//is a single call through a pointer. They are not offered to should_process() or
+		//should_react(), which take a listener object, and cannot be keyed or parallel.
+		template<typename EventT>
+		struct DelegateProcessor final
+		{
+			static_assert(std::is_base_of<Event, EventT>::value, "EventT must derive from Event");
+			using Event_t = EventT;
+			using Function_t = void (*)(void *context, EventT &e);
+			DelegateProcessor(Function_t f, void *context, ListenerPriority priority = ListenerPriority{}) noexcept
+			: delegate{f, context}
 			{
-				static_assert(std::is_base_of<Event, typename T::Event_t>::value, "Only Event can be root");
-				Unwrapper() = delete;
-				static void process(T &t) noexcept(T::NOEXCEPT)
-				{
-					T::Registrar_t::process(dynamic_cast<typename T::Event_t &>(t));
-				}
-				static void react(T const &t) noexcept(T::NOEXCEPT)
-				{
-					T::Registrar_t::react(dynamic_cast<typename T::Event_t const &>(t));
-				}
-				static auto parents(T &t) noexcept
+				listen(priority);
+			}
+			DelegateProcessor(Function_t f, void *context, ListenLater) noexcept
+			: delegate{f, context}
+			{
+			}
+			DelegateProcessor(DelegateProcessor const &) = delete;
+			DelegateProcessor &operator=(DelegateProcessor const &) = delete;
+			DelegateProcessor(DelegateProcessor &&) = delete;
+			DelegateProcessor &operator=(DelegateProcessor &&) = delete;
+			~DelegateProcessor() noexcept
+			{
+				ignore();
+			}
+
+			auto listen(ListenerPriority priority = ListenerPriority{}) noexcept
+			-> ListenerHandle
+			{
+				return Registrar<EventT>::listen(*this, priority);
+			}
+			void ignore() noexcept
+			{
+				return Registrar<EventT>::ignore(*this);
+			}
+			bool listening() const noexcept
+			{
+				return Registrar<EventT>::listening(*this);
+			}
+
+		private:
+			impl::Delegate<Function_t> const delegate;
+			ListenerHandle handle; //owned by the Registrar
+			Registrar<EventT> *owner = nullptr; //the Registrar this is listening to
+
+			friend Registrar<EventT>;
+		};
+		template<typename EventT>
+		struct DelegateReactor final
+		{
+			static_assert(std::is_base_of<Event, EventT>::value, "EventT must derive from Event");
+			using Event_t = EventT;
+			using Function_t = void (*)(void *context, EventT const &e);
+			DelegateReactor(Function_t f, void *context, ListenerPriority priority = ListenerPriority{}) noexcept
+			: delegate{f, context}
+			{
+				listen(priority);
+			}
+			DelegateReactor(Function_t f, void *context, ListenLater) noexcept
+			: delegate{f, context}
+			{
+			}
+			DelegateReactor(DelegateReactor const &) = delete;
+			DelegateReactor &operator=(DelegateReactor const &) = delete;
+			DelegateReactor(DelegateReactor &&) = delete;
+			DelegateReactor &operator=(DelegateReactor &&) = delete;
+			~DelegateReactor() noexcept
+			{
+				ignore();
+			}
+
+			auto listen(ListenerPriority priority = ListenerPriority{}) noexcept
+			-> ListenerHandle
+			{
+				return Registrar<EventT>::listen(*this, priority);
+			}
+			void ignore() noexcept
+			{
+				return Registrar<EventT>::ignore(*this);
+			}
+			bool listening() const noexcept
+			{
+				return Registrar<EventT>::listening(*this);
+			}
+
+		private:
+			impl::Delegate<Function_t> const delegate;
+			ListenerHandle handle; //owned by the Registrar
+			Registrar<EventT> *owner = nullptr; //the Registrar this is listening to
+
+			friend Registrar<EventT>;
+		};
+
+		namespace impl
+		{
+			//How a ListenerTable entry refers to its listener: by pointer, except for delegates,
+			//which are small enough to be copied into the entry itself
+			template<typename ListenerT>
+			struct Stored final
+			{
+				using type = ListenerT *;
+				static auto make(ListenerT &l) noexcept
+				-> type
+				{
+					return std::addressof(l);
+				}
+				static auto get(type const &s) noexcept
+				-> ListenerT *
+				{
+					return s;
+				}
+			};
+			template<typename FunctionT>
+			struct Stored<Delegate<FunctionT> const> final
+			{
+				using type = Delegate<FunctionT>;
+				static auto make(Delegate<FunctionT> const &l) noexcept
+				-> type
+				{
+					return l;
+				}
+				static auto get(type const &s) noexcept
+				-> Delegate<FunctionT> const *
+				{
+					return s? std::addressof(s) : nullptr;
+				}
+			};
+
+			//Listener storage in priority order, then in the order listening began. The listeners
+			//are linked through nodes which never move, and the last node of each priority in use
+			//is kept at hand, so listening, ignoring and changing priority never shift or renumber
+			//any other listener. Ignoring a listener during a dispatch leaves a tombstone in the list,
+			//and listeners added during a dispatch are held back, until the outermost one ends.
+			template<typename ListenerT>
+			struct ListenerTable final
+			{
+				using Priority_t = ListenerPriority::Priority_t;
+				using Slot_t = ListenerHandle::Slot_t;
+				struct Entry final
+				{
+					Priority_t priority;
+					typename Stored<ListenerT>::type listener; //nullptr once ignored
+					Slot_t slot;
+
+					auto get() const noexcept
+					-> ListenerT *
+					{
+						return Stored<ListenerT>::get(listener);
+					}
+				};
+				using Entries_t = std::vector<Entry>;
+
+			private:
+				static constexpr std::size_t END = ~std::size_t{0};
+				struct Node final
+				{
+					Entry entry;
+					std::size_t prev;
+					std::size_t next;
+				};
+				struct Last final
+				{
+					Priority_t priority;
+					std::size_t node;
+				};
+
+			public:
+				//Follows the list from one node to the next
+				struct Iterator final
+				{
+					using iterator_category = std::forward_iterator_tag;
+					using value_type = Entry;
+					using difference_type = std::ptrdiff_t;
+					using pointer = Entry const *;
+					using reference = Entry const &;
+
+					std::vector<Node> const *nodes = nullptr;
+					std::size_t i = END;
+
+					auto operator*() const noexcept
+					-> Entry const &
+					{
+						return (*nodes)[i].entry;
+					}
+					auto operator->() const noexcept
+					-> Entry const *
+					{
+						return &(*nodes)[i].entry;
+					}
+					auto operator++() noexcept
+					-> Iterator &
+					{
+						i = (*nodes)[i].next;
+						return *this;
+					}
+					auto operator++(int) noexcept
+					-> Iterator
+					{
+						auto const it = *this;
+						++*this;
+						return it;
+					}
+					friend bool operator==(Iterator const &a, Iterator const &b) noexcept
+					{
+						return a.i == b.i;
+					}
+					friend bool operator!=(Iterator const &a, Iterator const &b) noexcept
+					{
+						return a.i != b.i;
+					}
+				};
+
+				struct Dispatch final
+				{
+					Dispatch(ListenerTable &t) noexcept
+					: table(t)
+					{
+						++table.depth;
+					}
+					Dispatch(Dispatch const &) = delete;
+					Dispatch &operator=(Dispatch const &) = delete;
+					Dispatch(Dispatch &&) = delete;
+					Dispatch &operator=(Dispatch &&) = delete;
+					~Dispatch() noexcept
+					{
+						if(--table.depth == 0)
+						{
+							table.settle();
+						}
+					}
+
+					auto begin() const noexcept
+					-> Iterator
+					{
+						return {&table.nodes, table.head};
+					}
+					auto end() const noexcept
+					-> Iterator
+					{
+						return {&table.nodes, END};
+					}
+
+				private:
+					ListenerTable &table;
+				};
+
+				auto listen(ListenerT &l, ListenerPriority priority, ListenerHandle &h)
+				-> ListenerHandle
+				{
+					ignore(h);
+					return h = insert(l, priority);
+				}
+				void ignore(ListenerHandle &h) noexcept
+				{
+					if(h)
+					{
+						erase(h);
+						h = ListenerHandle{};
+					}
+				}
+
+				bool listening(ListenerHandle const &h) const noexcept
+				{
+					return static_cast<bool>(h);
+				}
+				//The listener h was returned for, or null if it has stopped listening since
+				auto find(ListenerHandle const &h) const noexcept
+				-> ListenerT *
+				{
+					auto const slot = h.index();
+					if(slot >= slots.size() || generations[slot] != h.generation() || slots[slot] == NONE)
+					{
+						return nullptr;
+					}
+					if(slots[slot] != PENDING)
+					{
+						return nodes[slots[slot]].entry.get();
+					}
+					for(auto const &e : pending)
+					{
+						if(e.slot == slot && e.listener)
+						{
+							return e.get();
+						}
+					}
+					return nullptr;
+				}
+				auto size() const noexcept
+				-> std::size_t
+				{
+					return slots.size() - unused.size();
+				}
+				bool empty() const noexcept
+				{
+					return size() == 0;
+				}
+				//Whether a Dispatch of this table is in progress
+				bool dispatched() const noexcept
+				{
+					return depth != 0;
+				}
+
+			private:
+				static constexpr Slot_t NONE = ListenerHandle::NONE;
+				static constexpr Slot_t PENDING = NONE - 1;
+
+				std::vector<Node> nodes;
+				std::size_t head = END;
+				std::vector<Last> lasts; //the last node of each priority in the list, by priority
+				std::vector<std::size_t> spare; //nodes which are not in the list
+				std::vector<std::size_t> doomed; //tombstones still in the list
+				Entries_t pending;
+				std::vector<std::size_t> slots; //slot -> node
+				std::vector<ListenerHandle::Generation_t> generations; //slot -> times it was freed
+				std::vector<Slot_t> unused;
+				std::size_t depth = 0;
+
+				auto insert(ListenerT &l, ListenerPriority priority)
+				-> ListenerHandle
+				{
+					Slot_t slot;
+					if(unused.empty())
+					{
+						slot = slots.size();
+						slots.push_back(NONE);
+						generations.push_back(0);
+					}
+					else
+					{
+						slot = unused.back();
+						unused.pop_back();
+					}
+					Entry const entry {priority, Stored<ListenerT>::make(l), slot};
+					if(depth != 0)
+					{
+						slots[slot] = PENDING;
+						pending.push_back(entry);
+					}
+					else
+					{
+						link(entry);
+					}
+					return ListenerHandle{slot, generations[slot]};
+				}
+				void erase(ListenerHandle h) noexcept
+				{
+					auto const slot = h.index();
+					auto const i = slots[slot];
+					if(i == PENDING)
+					{
+						for(auto &e : pending)
+						{
+							if(e.slot == slot)
+							{
+								e.listener = nullptr;
+							}
+						}
+					}
+					else
+					{
+						nodes[i].entry.listener = nullptr;
+						if(depth == 0)
+						{
+							unlink(i);
+						}
+						else
+						{
+							doomed.push_back(i);
+						}
+					}
+					slots[slot] = NONE;
+					++generations[slot];
+					unused.push_back(slot);
+				}
+				//After the last node whose priority is at most that of entry
+				void link(Entry const &entry)
+				{
+					std::size_t i;
+					if(spare.empty())
+					{
+						i = nodes.size();
+						nodes.push_back(Node{entry, END, END});
+					}
+					else
+					{
+						i = spare.back();
+						spare.pop_back();
+						nodes[i] = Node{entry, END, END};
+					}
+					auto const after = std::upper_bound(lasts.begin(), lasts.end(), entry.priority,
+						[](Priority_t p, Last const &l) noexcept
+						{
+							return p < l.priority;
+						});
+					auto const prev = (after == lasts.begin()? END : std::prev(after)->node);
+					auto &from = (prev == END? head : nodes[prev].next);
+					nodes[i].prev = prev;
+					nodes[i].next = from;
+					if(from != END)
+					{
+						nodes[from].prev = i;
+					}
+					from = i;
+					if(after != lasts.begin() && std::prev(after)->priority == entry.priority)
+					{
+						std::prev(after)->node = i;
+					}
+					else
+					{
+						lasts.insert(after, Last{entry.priority, i});
+					}
+					slots[entry.slot] = i;
+				}
+				void unlink(std::size_t i) noexcept
+				{
+					auto const &n = nodes[i];
+					(n.prev == END? head : nodes[n.prev].next) = n.next;
+					if(n.next != END)
+					{
+						nodes[n.next].prev = n.prev;
+					}
+					auto const last = std::lower_bound(lasts.begin(), lasts.end(), n.entry.priority,
+						[](Last const &l, Priority_t p) noexcept
+						{
+							return l.priority < p;
+						});
+					if(last->node == i)
+					{
+						if(n.prev != END && nodes[n.prev].entry.priority == n.entry.priority)
+						{
+							last->node = n.prev;
+						}
+						else
+						{
+							lasts.erase(last);
+						}
+					}
+					spare.push_back(i);
+				}
+				void settle() noexcept
+				{
+					for(auto const i : doomed)
+					{
+						unlink(i);
+					}
+					doomed.clear();
+					for(auto const &e : pending)
+					{
+						if(e.listener)
+						{
+							link(e);
+						}
+					}
+					pending.clear();
+				}
+			};
+
+#ifdef LB_EVENTS_CONCURRENT
+			//A dispatch in progress on the calling thread, linked to the one it is nested in
+			struct DispatchFrame final
+			{
+				void const *table;
+				DispatchFrame const *outer;
+			};
+			//The innermost dispatch in progress on the calling thread, across all registrars
+			inline auto dispatching() noexcept
+			-> DispatchFrame const *&
+			{
+				static thread_local DispatchFrame const *innermost = nullptr;
+				return innermost;
+			}
+			//Whether the calling thread is in the middle of dispatching table
+			inline bool dispatching(void const *table) noexcept
+			{
+				for(auto f = dispatching(); f; f = f->outer)
+				{
+					if(f->table == table)
+					{
+						return true;
+					}
+				}
+				return false;
+			}
+
+			//Two-counter epochs: readers announce themselves under the parity of the current epoch,
+			//and the epoch can only move on once the readers of the previous parity have left.
+			//Anything unpublished during epoch e is unreachable once the epoch reaches e + 2.
+			struct Epoch final
+			{
+				using Epoch_t = std::uint64_t;
+
+				auto enter() noexcept
+				-> Epoch_t
+				{
+					for(;;)
+					{
+						auto const e = epoch.load();
+						readers[e & 1].n.fetch_add(1);
+						if(epoch.load() == e)
+						{
+							return e;
+						}
+						readers[e & 1].n.fetch_sub(1);
+					}
+				}
+				void leave(Epoch_t e) noexcept
+				{
+					readers[e & 1].n.fetch_sub(1);
+				}
+
+				auto current() const noexcept
+				-> Epoch_t
+				{
+					return epoch.load();
+				}
+				//Callers must not advance concurrently
+				auto advance(bool wait) noexcept
+				-> bool
+				{
+					auto const e = epoch.load();
+					while(readers[(e + 1) & 1].n.load() != 0)
+					{
+						if(!wait)
+						{
+							return false;
+						}
+						std::this_thread::yield();
+					}
+					epoch.store(e + 1);
+					return true;
+				}
+
+			private:
+				struct alignas(64) Counter final
+				{
+					std::atomic<std::size_t> n {0};
+				};
+				alignas(64) std::atomic<Epoch_t> epoch {0};
+				Counter readers[2];
+			};
+
+			//Dispatch reads an immutable snapshot without locking; listen and ignore publish a new
+			//snapshot and retire the old one until no dispatch can still be reading it.
+			template<typename ListenerT>
+			struct ConcurrentListenerTable final
+			{
+				using Priority_t = ListenerPriority::Priority_t;
+				using Slot_t = ListenerHandle::Slot_t;
+				struct Cell final
+				{
+					std::atomic<ListenerT *> listener; //nullptr once ignored
+				};
+				struct Entry final
+				{
+					Priority_t priority;
+					Cell *cell;
+
+					auto get() const noexcept
+					-> ListenerT *
+					{
+						return cell->listener.load(std::memory_order_acquire);
+					}
+				};
+				using Entries_t = std::vector<Entry>;
+
+				struct Dispatch final
+				{
+					Dispatch(ConcurrentListenerTable &t) noexcept
+					: table(t)
+					, epoch{t.epoch.enter()}
+					, snapshot{t.current.load()}
+					, frame{&t, dispatching()}
+					{
+						dispatching() = &frame;
+					}
+					Dispatch(Dispatch const &) = delete;
+					Dispatch &operator=(Dispatch const &) = delete;
+					Dispatch(Dispatch &&) = delete;
+					Dispatch &operator=(Dispatch &&) = delete;
+					~Dispatch() noexcept
+					{
+						dispatching() = frame.outer;
+						table.epoch.leave(epoch);
+					}
+
+					auto begin() const noexcept
+					{
+						return snapshot->cbegin();
+					}
+					auto end() const noexcept
+					{
+						return snapshot->cend();
+					}
+
+				private:
+					ConcurrentListenerTable &table;
+					Epoch::Epoch_t const epoch;
+					Entries_t const *const snapshot;
+					DispatchFrame const frame;
+				};
+
+				ConcurrentListenerTable()
+				: current{new Entries_t}
+				{
+				}
+				ConcurrentListenerTable(ConcurrentListenerTable const &) = delete;
+				ConcurrentListenerTable &operator=(ConcurrentListenerTable const &) = delete;
+				ConcurrentListenerTable(ConcurrentListenerTable &&) = delete;
+				ConcurrentListenerTable &operator=(ConcurrentListenerTable &&) = delete;
+				~ConcurrentListenerTable() noexcept
+				{
+					std::unique_ptr<Entries_t const> const last {current.load()};
+					for(auto const &e : *last)
+					{
+						delete e.cell;
+					}
+				}
+
+				auto listen(ListenerT &l, ListenerPriority priority, ListenerHandle &h)
+				-> ListenerHandle
+				{
+					ListenerHandle result;
+					{
+						std::lock_guard<std::mutex> const lock {writer};
+						if(h)
+						{
+							erase(h);
+						}
+						result = h = insert(l, priority);
+					}
+					quiesce(false);
+					return result;
+				}
+				void ignore(ListenerHandle &h) noexcept
+				{
+					{
+						std::lock_guard<std::mutex> const lock {writer};
+						if(h)
+						{
+							erase(h);
+							h = ListenerHandle{};
+						}
+					}
+					//The listener is already unreachable for new dispatches, but dispatches in
+					//progress on other threads may still be calling it, so wait for them unless
+					//this thread is itself dispatching this table and could never finish waiting.
+					//Dispatches of other tables on this thread have their own epochs.
+					quiesce(!dispatching(this));
+				}
+
+				bool listening(ListenerHandle const &h) const noexcept
+				{
+					std::lock_guard<std::mutex> const lock {writer};
+					return static_cast<bool>(h);
+				}
+				//The listener h was returned for, or null if it has stopped listening since. Only
+				//a caller inside a Dispatch of this table may go on to call it.
+				auto find(ListenerHandle const &h) const noexcept
+				-> ListenerT *
+				{
+					std::lock_guard<std::mutex> const lock {writer};
+					auto const slot = h.index();
+					if(slot >= slots.size() || generations[slot] != h.generation() || !slots[slot])
+					{
+						return nullptr;
+					}
+					return slots[slot]->listener.load(std::memory_order_relaxed);
+				}
+				auto size() const noexcept
+				-> std::size_t
+				{
+					std::lock_guard<std::mutex> const lock {writer};
+					return live - dead;
+				}
+				//Without locking, for skipping tables which are usually empty
+				bool empty() const noexcept
+				{
+					return count.load(std::memory_order_relaxed) == 0;
+				}
+
+			private:
+				struct Retired final
+				{
+					Epoch::Epoch_t epoch;
+					std::unique_ptr<Entries_t const> entries;
+					std::vector<std::unique_ptr<Cell>> cells;
+				};
+
+				Epoch epoch;
+				std::atomic<Entries_t const *> current;
+				mutable std::mutex writer; //guards everything below
+				std::mutex grace; //serializes epoch advancement
+				std::vector<Cell *> slots; //slot -> cell
+				std::vector<ListenerHandle::Generation_t> generations; //slot -> times it was freed
+				std::vector<Slot_t> unused;
+				std::vector<Retired> retired;
+				std::size_t dead = 0;
+				std::size_t live = 0;
+				std::atomic<std::size_t> count {0};
+
+				//Both require the writer lock
+				auto insert(ListenerT &l, ListenerPriority priority)
+				-> ListenerHandle
+				{
+					Slot_t slot;
+					if(unused.empty())
+					{
+						slot = slots.size();
+						slots.push_back(nullptr);
+						generations.push_back(0);
+					}
+					else
+					{
+						slot = unused.back();
+						unused.pop_back();
+					}
+					auto const cell = slots[slot] = new Cell{std::addressof(l)};
+					auto next = copy();
+					auto const pos = std::upper_bound(next->begin(), next->end(), Priority_t{priority},
+						[](Priority_t p, Entry const &e) noexcept
+						{
+							return p < e.priority;
+						});
+					next->insert(pos, Entry{priority, cell});
+					publish(std::move(next));
+					count.fetch_add(1, std::memory_order_relaxed);
+					return ListenerHandle{slot, generations[slot]};
+				}
+				void erase(ListenerHandle h) noexcept
+				{
+					auto const slot = h.index();
+					slots[slot]->listener.store(nullptr, std::memory_order_release);
+					slots[slot] = nullptr;
+					++generations[slot];
+					unused.push_back(slot);
+					count.fetch_sub(1, std::memory_order_relaxed);
+					if(++dead*2 > live)
+					{
+						publish(copy());
+					}
+				}
+
+				//Copies the current snapshot without its tombstones
+				auto copy() const
+				-> std::unique_ptr<Entries_t>
+				{
+					std::unique_ptr<Entries_t> next {new Entries_t};
+					auto const now = current.load();
+					next->reserve(now->size() - dead + 1);
+					for(auto const &e : *now)
+					{
+						if(e.get())
+						{
+							next->push_back(e);
+						}
+					}
+					return next;
+				}
+				void publish(std::unique_ptr<Entries_t> next)
+				{
+					live = next->size();
+					dead = 0;
+					Retired r {0, std::unique_ptr<Entries_t const>{current.exchange(next.release())}, {}};
+					//Tagging after unpublishing means no new dispatch can reach the old snapshot
+					r.epoch = epoch.current();
+					for(auto const &e : *r.entries)
+					{
+						if(!e.get())
+						{
+							r.cells.emplace_back(e.cell);
+						}
+					}
+					retired.push_back(std::move(r));
+				}
+				void quiesce(bool wait) noexcept
+				{
+					{
+						std::unique_lock<std::mutex> lock {grace, std::defer_lock};
+						if(wait)
+						{
+							lock.lock();
+						}
+						else if(!lock.try_lock())
+						{
+							return;
+						}
+						if(epoch.advance(wait))
+						{
+							epoch.advance(wait);
+						}
+					}
+					std::unique_lock<std::mutex> const lock {writer};
+					auto const now = epoch.current();
+					retired.erase(std::remove_if(retired.begin(), retired.end(),
+						[&](Retired const &r) noexcept
+						{
+							return r.epoch + 2 <= now;
+						}), retired.end());
+				}
+			};
+
+			template<typename ListenerT>
+			using ListenerTable_t = ConcurrentListenerTable<ListenerT>;
+#else
+			template<typename ListenerT>
+			using ListenerTable_t = ListenerTable<ListenerT>;
+#endif
+
+#ifdef LB_EVENTS_CONCURRENT
+			//One ListenerTable_t per key, created on demand and dropped once nobody listens to it.
+			//Dispatches look the key up in an immutable snapshot of the keys without locking,
+			//and what they found stays alive until they are done with it, like the snapshots of
+			//ConcurrentListenerTable.
+			template<typename ListenerT>
+			struct KeyedListenerTable final
+			{
+				using Table_t = ListenerTable_t<ListenerT>;
+				using Tables_t = std::unordered_map<ListenerKey::Key_t, Table_t *>;
+
+				//The table of a key, or null; it cannot be destroyed while this exists
+				struct Found final
+				{
+					Found(std::nullptr_t) noexcept
+					{
+					}
+					Found(KeyedListenerTable const &k, ListenerKey key) noexcept
+					: keyed{&k}
+					, epoch{k.epoch.enter()}
+					{
+						auto const &tables = *k.current.load();
+						auto const it = tables.find(key.value());
+						table = it == tables.end()? nullptr : it->second;
+					}
+					Found(Found const &) = delete;
+					Found &operator=(Found const &) = delete;
+					Found(Found &&) = delete;
+					Found &operator=(Found &&) = delete;
+					~Found() noexcept
+					{
+						if(keyed)
+						{
+							keyed->epoch.leave(epoch);
+						}
+					}
+
+					explicit operator bool() const noexcept
+					{
+						return table != nullptr;
+					}
+					auto operator*() const noexcept
+					-> Table_t &
+					{
+						return *table;
+					}
+					auto operator->() const noexcept
+					-> Table_t *
+					{
+						return table;
+					}
+
+				private:
+					KeyedListenerTable const *keyed = nullptr;
+					Epoch::Epoch_t epoch = 0;
+					Table_t *table = nullptr;
+				};
+
+				KeyedListenerTable()
+				: current{new Tables_t}
+				{
+				}
+				KeyedListenerTable(KeyedListenerTable const &) = delete;
+				KeyedListenerTable &operator=(KeyedListenerTable const &) = delete;
+				KeyedListenerTable(KeyedListenerTable &&) = delete;
+				KeyedListenerTable &operator=(KeyedListenerTable &&) = delete;
+				~KeyedListenerTable() noexcept
+				{
+					std::unique_ptr<Tables_t const> const last {current.load()};
+					for(auto const &t : *last)
+					{
+						delete t.second;
+					}
+				}
+
+				auto listen(ListenerT &l, ListenerPriority priority, ListenerKey key, ListenerHandle &h)
+				-> ListenerHandle
+				{
+					ListenerHandle result;
+					{
+						//Locked throughout so that the table cannot be dropped before l is in it
+						std::lock_guard<std::mutex> const lock {writer};
+						auto const &tables = *current.load();
+						auto const it = tables.find(key.value());
+						auto t = it == tables.end()? nullptr : it->second;
+						if(!t)
+						{
+							std::unique_ptr<Table_t> made {new Table_t};
+							std::unique_ptr<Tables_t> next {new Tables_t{tables}};
+							next->emplace(key.value(), made.get());
+							t = made.release();
+							publish(std::move(next), nullptr);
+						}
+						result = t->listen(l, priority, h);
+					}
+					quiesce();
+					return result;
+				}
+				void ignore(ListenerKey key, ListenerHandle &h) noexcept
+				{
+					{
+						Found const t {*this, key};
+						if(!t)
+						{
+							return;
+						}
+						//Not locked, since this may have to wait for dispatches which listen or ignore
+						t->ignore(h);
+						std::lock_guard<std::mutex> const lock {writer};
+						auto const &tables = *current.load();
+						auto const it = tables.find(key.value());
+						if(it == tables.end() || it->second != &*t || t->size() != 0)
+						{
+							return;
+						}
+						std::unique_ptr<Tables_t> next {new Tables_t{tables}};
+						next->erase(key.value());
+						publish(std::move(next), &*t);
+					}
+					//Never waits, since dispatches on this thread may still hold on to what they found
+					quiesce();
+				}
+
+				auto find(ListenerKey key) const noexcept
+				-> Found
+				{
+					return {*this, key};
+				}
+				bool empty() const noexcept
+				{
+					return count.load(std::memory_order_relaxed) == 0;
+				}
+				auto size() const noexcept
+				-> std::size_t
+				{
+					std::lock_guard<std::mutex> const lock {writer};
+					std::size_t n = 0;
+					for(auto const &t : *current.load())
+					{
+						n += t.second->size();
+					}
+					return n;
+				}
+
+			private:
+				struct Retired final
+				{
+					Epoch::Epoch_t epoch;
+					std::unique_ptr<Tables_t const> tables;
+					std::unique_ptr<Table_t> dropped;
+				};
+
+				mutable Epoch epoch;
+				std::atomic<Tables_t const *> current;
+				mutable std::mutex writer; //guards everything below
+				std::mutex grace; //serializes epoch advancement
+				std::vector<Retired> retired;
+				std::atomic<std::size_t> count {0};
+
+				//Requires the writer lock
+				void publish(std::unique_ptr<Tables_t> next, Table_t *dropped)
+				{
+					count.store(next->size(), std::memory_order_relaxed);
+					Retired r {0, std::unique_ptr<Tables_t const>{current.exchange(next.release())}, std::unique_ptr<Table_t>{dropped}};
+					//Tagging after unpublishing means no new dispatch can reach the old snapshot
+					r.epoch = epoch.current();
+					retired.push_back(std::move(r));
+				}
+				void quiesce() noexcept
+				{
+					{
+						std::unique_lock<std::mutex> lock {grace, std::try_to_lock};
+						if(!lock || !epoch.advance(false))
+						{
+							return;
+						}
+						epoch.advance(false);
+					}
+					std::lock_guard<std::mutex> const lock {writer};
+					auto const now = epoch.current();
+					retired.erase(std::remove_if(retired.begin(), retired.end(),
+						[&](Retired const &r) noexcept
+						{
+							return r.epoch + 2 <= now;
+						}), retired.end());
+				}
+			};
+#else
+			//One ListenerTable_t per key, created on demand and dropped once nobody listens to it.
+			//A table which empties while it is being dispatched is kept for the next listener of
+			//its key instead.
+			template<typename ListenerT>
+			struct KeyedListenerTable final
+			{
+				using Table_t = ListenerTable_t<ListenerT>;
+
+				auto listen(ListenerT &l, ListenerPriority priority, ListenerKey key, ListenerHandle &h)
+				-> ListenerHandle
+				{
+					auto &t = tables[key.value()];
+					if(!t)
+					{
+						t.reset(new Table_t);
+					}
+					if(t->empty())
+					{
+						++live;
+					}
+					return t->listen(l, priority, h);
+				}
+				void ignore(ListenerKey key, ListenerHandle &h) noexcept
+				{
+					auto const it = tables.find(key.value());
+					if(it == tables.end() || !h)
+					{
+						return;
+					}
+					auto &t = *it->second;
+					t.ignore(h);
+					if(t.empty())
+					{
+						--live;
+						if(!t.dispatched())
+						{
+							tables.erase(it);
+						}
+					}
+				}
+
+				auto find(ListenerKey key) const noexcept
+				-> Table_t *
+				{
+					auto const it = tables.find(key.value());
+					return it == tables.end()? nullptr : it->second.get();
+				}
+				bool empty() const noexcept
+				{
+					return live == 0;
+				}
+				auto size() const noexcept
+				-> std::size_t
+				{
+					std::size_t n = 0;
+					for(auto const &t : tables)
+					{
+						n += t.second->size();
+					}
+					return n;
+				}
+
+			private:
+				std::unordered_map<ListenerKey::Key_t, std::unique_ptr<Table_t>> tables;
+				std::size_t live = 0; //tables with listeners
+			};
+#endif
+
+			//Visits the entries of two tables in priority order, those of all first when equal,
+			//until f returns false
+			template<typename TableT, typename F>
+			void merge(TableT &all, TableT &keyed, F &&f)
+			{
+				typename TableT::Dispatch const a {all};
+				typename TableT::Dispatch const k {keyed};
+				auto i = a.begin();
+				auto j = k.begin();
+				while(i != a.end() || j != k.end())
+				{
+					auto const &entry = (j == k.end() || (i != a.end() && i->priority <= j->priority))? *i++ : *j++;
+					if(!f(entry.priority, entry.get()))
+					{
+						break;
+					}
+				}
+			}
+
+			//Walks the delegates of a table alongside the other listeners, without entering a
+			//dispatch at all when there are none or when none of them are to be called
+			template<typename TableT>
+			struct Delegates final
+			{
+				using Priority_t = ListenerPriority::Priority_t;
+				using It_t = decltype(std::declval<typename TableT::Dispatch const &>().begin());
+
+				Delegates(TableT &t, bool called = true) noexcept
+				{
+					if(called && !t.empty())
+					{
+						dispatch.emplace(t);
+						next = dispatch->begin();
+						end = dispatch->end();
+					}
+				}
+
+				//Calls f with each delegate whose priority is at most until, in order, until f
+				//returns false for one, which is then next again
+				template<typename F>
+				void until(Priority_t until, F &&f)
+				{
+					for(; next != end && next->priority <= until; ++next)
+					{
+						auto const d = next->get();
+						if(d && !f(next->priority, *d))
+						{
+							return;
+						}
+					}
+				}
+
+			private:
+				std::optional<typename TableT::Dispatch> dispatch;
+				It_t next {};
+				It_t end {};
+			};
+
+			//How far a react phase which was suspended part way has got through the reactors of
+			//one Registrar, see BudgetedDispatcher
+			struct ReactCursor final
+			{
+				using Priority_t = ListenerPriority::Priority_t;
+				//A reactor, or a delegate by its function and context
+				struct Id final
+				{
+					void const *listener;
+					void (*function)();
+
+					friend bool operator==(Id const &a, Id const &b) noexcept
+					{
+						return a.listener == b.listener && a.function == b.function;
+					}
+				};
+
+				bool entered = false;
+				bool finished = false;
+				std::size_t statics = 0; //static reactors which already reacted
+
+				//Called at the start of every pass over the reactors
+				void resume() noexcept
+				{
+					matched = 0;
+					earlier = done.size();
+					missed[0] = missed[1] = false;
+				}
+				//Called for each reactor in order; whether it reacted in an earlier pass
+				bool reacted(Priority_t p, Id id) noexcept
+				{
+					if(p != priority)
+					{
+						return p < priority;
+					}
+					//Delegates and reactors each keep their order, so once one of a kind has not
+					//reacted none of the rest of that kind have, even if it reuses the address of
+					//one which has since been ignored
+					auto &miss = missed[id.function != nullptr];
+					if(miss)
+					{
+						return false;
+					}
+					auto const first = done.begin() + static_cast<std::ptrdiff_t>(matched);
+					auto const last = done.begin() + static_cast<std::ptrdiff_t>(earlier);
+					auto const it = std::find(first, last, id);
+					if(it == last)
+					{
+						miss = true;
+						return false;
+					}
+					matched = static_cast<std::size_t>(it - done.begin()) + 1;
+					return true;
+				}
+				void reacting(Priority_t p, Id id)
+				{
+					if(p != priority)
+					{
+						priority = p;
+						done.clear();
+						matched = earlier = 0;
+					}
+					done.push_back(id);
+				}
+
+			private:
+				Priority_t priority = ListenerPriority::FIRST;
+				std::vector<Id> done; //the reactors of priority which already reacted
+				std::size_t matched = 0;
+				std::size_t earlier = 0; //how many of done reacted before this pass
+				bool missed[2] = {}; //by whether a delegate
+			};
+
+			//Which levels of an event type's Hierarchy_t have listeners for one phase, so that
+			//calling it skips the classes nobody listens to. Every Registrar counts the changes to
+			//its own listeners of the phase, and entry i remembers whether level i had listeners
+			//at the count its Registrar had then, so listening to one event type never makes the
+			//others look again; levels past the last entry are always visited. Checked again at
+			//every level, since listeners may come and go mid-dispatch.
+			struct Levels final
+			{
+				static constexpr std::size_t BITS = 32;
+
+				Levels() noexcept
+				{
+					for(auto &entry : entries)
+					{
+						entry.store(STALE, std::memory_order_relaxed);
+					}
+				}
+				Levels(Levels const &) = delete;
+				Levels &operator=(Levels const &) = delete;
+				Levels(Levels &&) = delete;
+				Levels &operator=(Levels &&) = delete;
+				~Levels() noexcept = default;
+
+				//After every listen() and ignore() of the phase in the Registrar which owns this
+				void changed() noexcept
+				{
+					version.fetch_add(2, std::memory_order_release);
+				}
+
+				//LevelT is the class at level in the hierarchy of the Registrar which owns this
+				template<typename LevelT, bool PROCESS>
+				bool visit(std::size_t level) noexcept
+				{
+#ifdef LB_EVENTS_METRICS
+					//Every class counts every event, listened to or not
+					static_cast<void>(level);
+					return true;
+#else
+					if(level >= BITS)
+					{
+						return true;
+					}
+					using Registrar_t = typename LevelT::Registrar_t;
+					auto const current = Registrar_t::template levels<PROCESS>().version.load(std::memory_order_acquire);
+					auto &entry = entries[level];
+					auto cached = entry.load(std::memory_order_relaxed);
+					if((cached | 1) != (current | 1))
+					{
+						bool const listened = (PROCESS? Registrar_t::processing() : Registrar_t::reacting());
+						cached = current | (listened? 1u : 0u);
+						entry.store(cached, std::memory_order_relaxed);
+					}
+					return (cached & 1) != 0;
+#endif
+				}
+
+			private:
+				//Never current until the version wraps around, and then means the level is visited
+				static constexpr std::uint32_t STALE = ~std::uint32_t{0};
+				//Always even, so that bit 0 of an entry is free
+				std::atomic<std::uint32_t> version {0};
+				//The version of level i's Levels, with bit 0 set if it had listeners
+				std::array<std::atomic<std::uint32_t>, BITS> entries;
+			};
+		}
+
+#ifdef LB_EVENTS_METRICS
+		//A snapshot of the statistics of one event type's Registrar. An event is counted once by
+		//every Registrar in its hierarchy, so the counts of a parent include its children.
+		struct EventMetrics final
+		{
+			//Bucket i counts dispatches which took [2^(i-1), 2^i) nanoseconds, the last one any longer
+			static constexpr std::size_t BUCKETS = 32;
+			using Histogram_t = std::array<std::uint64_t, BUCKETS>;
+
+			struct Phase final
+			{
+				std::uint64_t events;
+				Histogram_t ns;
+			};
+
+			char const *name;
+			std::size_t processors;
+			std::size_t reactors;
+			Phase process;
+			Phase react;
+		};
+
+		namespace impl
+		{
+			struct Metrics final
+			{
+				using Count_t = std::size_t (*)(void const *registrar) noexcept;
+
+				struct Phase final
+				{
+					std::atomic<std::uint64_t> events {};
+					std::array<std::atomic<std::uint64_t>, EventMetrics::BUCKETS> ns {};
+
+					auto snapshot() const noexcept
+					-> EventMetrics::Phase
+					{
+						EventMetrics::Phase p {events.load(std::memory_order_relaxed), {}};
+						for(std::size_t i = 0; i < EventMetrics::BUCKETS; ++i)
+						{
+							p.ns[i] = ns[i].load(std::memory_order_relaxed);
+						}
+						return p;
+					}
+				};
+
+				//Times one dispatch of n events
+				struct Metered final
+				{
+					Metered(Phase &p, std::uint64_t n) noexcept
+					: phase(p)
+					, start{std::chrono::steady_clock::now()}
+					{
+						phase.events.fetch_add(n, std::memory_order_relaxed);
+					}
+					Metered(Metered const &) = delete;
+					Metered &operator=(Metered const &) = delete;
+					Metered(Metered &&) = delete;
+					Metered &operator=(Metered &&) = delete;
+					~Metered() noexcept
+					{
+						auto const ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+						std::size_t bucket = 0;
+						while(bucket + 1 < EventMetrics::BUCKETS && (ns >> bucket) != 0)
+						{
+							++bucket;
+						}
+						phase.ns[bucket].fetch_add(1, std::memory_order_relaxed);
+					}
+
+				private:
+					Phase &phase;
+					std::chrono::steady_clock::time_point const start;
+				};
+
+				char const *const name;
+				void const *const registrar;
+				Count_t const processors;
+				Count_t const reactors;
+				Phase process;
+				Phase react;
+
+				Metrics(char const *n, void const *r, Count_t ps, Count_t rs) noexcept
+				: name{n}
+				, registrar{r}
+				, processors{ps}
+				, reactors{rs}
+				{
+					std::lock_guard<std::mutex> const lock {mutex()};
+					all().push_back(this);
+				}
+				Metrics(Metrics const &) = delete;
+				Metrics &operator=(Metrics const &) = delete;
+				Metrics(Metrics &&) = delete;
+				Metrics &operator=(Metrics &&) = delete;
+				~Metrics() noexcept
+				{
+					std::lock_guard<std::mutex> const lock {mutex()};
+					all().erase(std::find(all().begin(), all().end(), this));
+				}
+
+				//Every Registrar which currently exists, oldest first
+				static auto all() noexcept
+				-> std::vector<Metrics const *> &
+				{
+					static std::vector<Metrics const *> registrars;
+					return registrars;
+				}
+				static auto mutex() noexcept
+				-> std::mutex &
+				{
+					static std::mutex m;
+					return m;
+				}
+			};
+		}
+
+		//Lists every event type which has been listened to or called so far, once per EventDomain
+		inline auto metrics()
+		-> std::vector<EventMetrics>
+		{
+			std::vector<EventMetrics> all;
+			std::lock_guard<std::mutex> const lock {impl::Metrics::mutex()};
+			for(auto const m : impl::Metrics::all())
+			{
+				all.push_back({m->name, m->processors(m->registrar), m->reactors(m->registrar), m->process.snapshot(), m->react.snapshot()});
+			}
+			return all;
+		}
+#endif
+
+#ifdef LB_EVENTS_TRACING
+		namespace impl
+		{
+			//Timestamps for trace records: the time stamp counter where there is one, since it is
+			//much cheaper to read than a clock, otherwise steady_clock nanoseconds
+			inline auto ticks() noexcept
+			-> std::uint64_t
+			{
+#ifdef LB_EVENTS_IMPL_TSC
+				return __rdtsc();
+#else
+				return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+			}
+
+			struct Trace final
+			{
+				//One per thread which has recorded anything, written only by that thread and read
+				//by write_trace() without stopping it
+				struct Buffer final
+				{
+					static constexpr std::size_t CAPACITY = std::size_t{1} << 13;
+					struct Record final
+					{
+						std::atomic<std::uint64_t> seq; //index + 1 once written, 0 while being written
+						std::atomic<std::uint64_t> ticks;
+						std::atomic<void const *> id;
+						std::atomic<char const *> name;
+						std::atomic<std::uint8_t> kind;
+					};
+
+					std::array<Record, CAPACITY> records {};
+					std::atomic<std::uint64_t> head {0}; //index of the next record
+					//Both guarded by mutex()
+					std::uint64_t start = 0; //index of the first record of the current thread
+					std::size_t thread = 0;
+					bool owned = true;
+
+					void record(std::uint8_t kind, void const *id, char const *name) noexcept
+					{
+						auto const i = head.load(std::memory_order_relaxed);
+						auto &r = records[i & (CAPACITY - 1)];
+						r.seq.store(0, std::memory_order_relaxed);
+						std::atomic_thread_fence(std::memory_order_release);
+						r.ticks.store(ticks(), std::memory_order_relaxed);
+						r.id.store(id, std::memory_order_relaxed);
+						r.name.store(name, std::memory_order_relaxed);
+						r.kind.store(kind, std::memory_order_relaxed);
+						r.seq.store(i + 1, std::memory_order_release);
+						head.store(i + 1, std::memory_order_release);
+					}
+				};
+
+				static auto enabled() noexcept
+				-> std::atomic<bool> &
+				{
+					static std::atomic<bool> on {false};
+					return on;
+				}
+				//The buffer of the calling thread, handed on to a later thread once it exits
+				static auto buffer()
+				-> Buffer &
+				{
+					struct Owner final
+					{
+						Buffer *b;
+						Owner()
+						{
+							std::lock_guard<std::mutex> const lock {mutex()};
+							auto &all = buffers();
+							auto const it = std::find_if(all.begin(), all.end(), [](std::unique_ptr<Buffer> const &b){ return !b->owned; });
+							if(it == all.end())
+							{
+								all.emplace_back(new Buffer);
+								b = all.back().get();
+							}
+							else
+							{
+								b = it->get();
+								b->owned = true;
+								b->start = b->head.load(std::memory_order_relaxed);
+							}
+							b->thread = next_thread()++;
+						}
+						~Owner() noexcept
+						{
+							std::lock_guard<std::mutex> const lock {mutex()};
+							b->owned = false;
+						}
+					};
+					//Checking a plain pointer first keeps the guard of owner off the common path
+					thread_local Buffer *b = nullptr;
+					if(!b)
+					{
+						thread_local Owner const owner;
+						b = owner.b;
+					}
+					return *b;
+				}
+				static auto buffers() noexcept
+				-> std::vector<std::unique_ptr<Buffer>> &
+				{
+					static std::vector<std::unique_ptr<Buffer>> all;
+					return all;
+				}
+				static auto next_thread() noexcept
+				-> std::size_t &
+				{
+					static std::size_t next = 1;
+					return next;
+				}
+				static auto mutex() noexcept
+				-> std::mutex &
+				{
+					static std::mutex m;
+					return m;
+				}
+			};
+
+			//Records the beginning and end of something in the trace of the calling thread, if
+			//tracing was on when it began
+			struct Span final
+			{
+				enum Kind : std::uint8_t
+				{
+					CALL,
+					PROCESS, //one Registrar, name is the event type
+					REACT,
+					PROCESSOR, //one listener, id is the listener or its context
+					REACTOR,
+					END = 0x80
+				};
+
+				Span(Kind k, void const *i, char const *n = nullptr) noexcept
+				: kind{k}
+				, id{i}
+				, name{n}
+				, buffer{Trace::enabled().load(std::memory_order_relaxed)? &Trace::buffer() : nullptr}
+				{
+					if(buffer)
+					{
+						buffer->record(kind, id, name);
+					}
+				}
+				Span(Span const &) = delete;
+				Span &operator=(Span const &) = delete;
+				Span(Span &&) = delete;
+				Span &operator=(Span &&) = delete;
+				~Span() noexcept
+				{
+					if(buffer)
+					{
+						buffer->record(kind | END, id, name);
+					}
+				}
+
+			private:
+				Kind const kind;
+				void const *const id;
+				char const *const name;
+				Trace::Buffer *const buffer;
+			};
+		}
+#else
+		namespace impl
+		{
+			struct Span final
+			{
+				enum Kind : std::uint8_t
+				{
+					CALL,
+					PROCESS,
+					REACT,
+					PROCESSOR,
+					REACTOR
+				};
+
+				constexpr Span(Kind, void const *, char const * = nullptr) noexcept
+				{
+				}
+			};
+		}
+#endif
+
+		template<typename EventT>
+		struct Registrar final
+		{
+			static_assert(std::is_base_of<Event, EventT>::value, "EventT must derive from Event");
+			using Event_t = EventT;
+			using Processor_t = Processor<EventT>;
+			using Reactor_t = Reactor<EventT>;
+			using DelegateProcessor_t = DelegateProcessor<EventT>;
+			using DelegateReactor_t = DelegateReactor<EventT>;
+			using Priority_t = ListenerPriority::Priority_t;
+
+			//Listens to the Registrar of the current EventDomain, moving l out of any other
+			static auto listen(Processor_t const &p, ListenerPriority priority = ListenerPriority{}) noexcept
+			-> ListenerHandle
+			{
+				auto &self = Event_t::registrar();
+				if(p.key || (p.owner && p.owner != &self))
+				{
+					ignore(p);
+				}
+				p.owner = &self;
+				auto const h = self.ps.listen(p, priority, p.handle);
+				self.pl.changed();
+				return h;
+			}
+			static auto listen(Reactor_t &r, ListenerPriority priority = ListenerPriority{}) noexcept
+			-> ListenerHandle
+			{
+				auto &self = Event_t::registrar();
+				if(r.key || (r.owner && r.owner != &self))
+				{
+					ignore(r);
+				}
+				r.owner = &self;
+				auto const h = self.rs.listen(r, priority, r.handle);
+				self.rl.changed();
+				return h;
+			}
+			//Only for events whose key() is key
+			static auto listen(Processor_t const &p, ListenerKey key, ListenerPriority priority = ListenerPriority{}) noexcept
+			-> ListenerHandle
+			{
+				if(!key)
+				{
+					return listen(p, priority);
+				}
+				ignore(p);
+				auto &self = Event_t::registrar();
+				p.key = key;
+				p.owner = &self;
+				auto const h = self.kps.listen(p, priority, key, p.handle);
+				self.pl.changed();
+				return h;
+			}
+			static auto listen(Reactor_t &r, ListenerKey key, ListenerPriority priority = ListenerPriority{}) noexcept
+			-> ListenerHandle
+			{
+				if(!key)
+				{
+					return listen(r, priority);
+				}
+				ignore(r);
+				auto &self = Event_t::registrar();
+				r.key = key;
+				r.owner = &self;
+				auto const h = self.krs.listen(r, priority, key, r.handle);
+				self.rl.changed();
+				return h;
+			}
+
+			//Stops listening to whichever Registrar l listens to, from any EventDomain
+			static void ignore(Processor_t const &p) noexcept
+			{
+				if(!p.owner)
+				{
+					return;
+				}
+				if(p.key)
+				{
+					p.owner->kps.ignore(p.key, p.handle);
+					p.key = ListenerKey{};
+				}
+				else
+				{
+					p.owner->ps.ignore(p.handle);
+				}
+				p.owner->pl.changed();
+				p.owner = nullptr;
+			}
+			static void ignore(Reactor_t &r) noexcept
+			{
+				if(!r.owner)
+				{
+					return;
+				}
+				if(r.key)
+				{
+					r.owner->krs.ignore(r.key, r.handle);
+					r.key = ListenerKey{};
+				}
+				else
+				{
+					r.owner->rs.ignore(r.handle);
+				}
+				r.owner->rl.changed();
+				r.owner = nullptr;
+			}
+
+			static bool listening(Processor_t const &p) noexcept
+			{
+				if(!p.owner)
+				{
+					return false;
+				}
+				return p.key? static_cast<bool>(p.owner->kps.find(p.key)) : p.owner->ps.listening(p.handle);
+			}
+			static bool listening(Reactor_t const &r) noexcept
+			{
+				if(!r.owner)
+				{
+					return false;
+				}
+				return r.key? static_cast<bool>(r.owner->krs.find(r.key)) : r.owner->rs.listening(r.handle);
+			}
+
+			static auto listen(DelegateProcessor_t &p, ListenerPriority priority = ListenerPriority{}) noexcept
+			-> ListenerHandle
+			{
+				auto &self = Event_t::registrar();
+				if(p.owner && p.owner != &self)
+				{
+					ignore(p);
+				}
+				p.owner = &self;
+				auto const h = self.dps.listen(p.delegate, priority, p.handle);
+				self.pl.changed();
+				return h;
+			}
+			static auto listen(DelegateReactor_t &r, ListenerPriority priority = ListenerPriority{}) noexcept
+			-> ListenerHandle
+			{
+				auto &self = Event_t::registrar();
+				if(r.owner && r.owner != &self)
+				{
+					ignore(r);
+				}
+				r.owner = &self;
+				auto const h = self.drs.listen(r.delegate, priority, r.handle);
+				self.rl.changed();
+				return h;
+			}
+			static void ignore(DelegateProcessor_t &p) noexcept
+			{
+				if(p.owner)
+				{
+					p.owner->dps.ignore(p.handle);
+					p.owner->pl.changed();
+					p.owner = nullptr;
+				}
+			}
+			static void ignore(DelegateReactor_t &r) noexcept
+			{
+				if(r.owner)
+				{
+					r.owner->drs.ignore(r.handle);
+					r.owner->rl.changed();
+					r.owner = nullptr;
+				}
+			}
+			static bool listening(DelegateProcessor_t const &p) noexcept
+			{
+				return p.owner && p.owner->dps.listening(p.handle);
+			}
+			static bool listening(DelegateReactor_t const &r) noexcept
+			{
+				return r.owner && r.owner->drs.listening(r.handle);
+			}
+
+			//Whether anything processes, or reacts to, EventT itself in the current EventDomain
+			static bool processing() noexcept
+			{
+				auto const &self = Event_t::registrar();
+				return Static_t::PROCESSORS != 0 || !self.ps.empty() || !self.kps.empty() || !self.dps.empty();
+			}
+			static bool reacting() noexcept
+			{
+				auto const &self = Event_t::registrar();
+				return Static_t::REACTORS != 0 || !self.rs.empty() || !self.krs.empty() || !self.drs.empty();
+			}
+			//Which classes in the hierarchy of events whose most derived type is EventT have
+			//listeners, see Hierarchy_t
+			template<bool PROCESS>
+			static auto levels() noexcept
+			-> impl::Levels &
+			{
+				auto &self = Event_t::registrar();
+				return PROCESS? self.pl : self.rl;
+			}
+
+			static void process(Event_t &e) noexcept(EventT::NOEXCEPT)
+			{
+				auto &self = Event_t::registrar();
+#ifdef LB_EVENTS_METRICS
+				impl::Metrics::Metered const metered {self.m.process, 1};
+#endif
+#ifdef LB_EVENTS_TRACING
+				impl::Span const span {impl::Span::PROCESS, &self, self.name};
+#endif
+				std::size_t statics = 0;
+				impl::Delegates<DelegateProcessors_t> delegates {self.dps};
+				auto const visit = [&](Priority_t priority, Processor_t const *l)
+				{
+					process_ahead(e, statics, delegates, priority);
+					if(e.processing_stopped())
+					{
+						return false;
+					}
+					if(l && e.should_process(*l))
+					{
+						impl::Span const span {impl::Span::PROCESSOR, l};
+						l->process(e);
+					}
+					return true;
+				};
+				if(auto const keyed = find(self.kps, e))
+				{
+					impl::merge(self.ps, *keyed, visit);
+				}
+				else
+				{
+					typename Processors_t::Dispatch const d {self.ps};
+					for(auto const &p : d)
+					{
+						if(!visit(p.priority, p.get()))
+						{
+							break;
+						}
+					}
+				}
+				process_ahead(e, statics, delegates, ListenerPriority::LAST);
+			}
+			static void react(Event_t const &e) noexcept(EventT::NOEXCEPT)
+			{
+				auto &self = Event_t::registrar();
+#ifdef LB_EVENTS_METRICS
+				impl::Metrics::Metered const metered {self.m.react, 1};
+#endif
+#ifdef LB_EVENTS_TRACING
+				impl::Span const span {impl::Span::REACT, &self, self.name};
+#endif
+				std::size_t statics = first_static(e);
+				impl::Delegates<DelegateReactors_t> delegates {self.drs, delegates_react(self, e)};
+				//Parallel reactors are run one at a time among keyed reactors
+				if(auto const keyed = find(self.krs, e))
+				{
+					impl::merge(self.rs, *keyed, [&](Priority_t priority, Reactor_t *l)
+					{
+						react_ahead(e, statics, delegates, priority);
+						if(l && reacts(e, *l))
+						{
+							impl::Span const span {impl::Span::REACTOR, l};
+							l->react(e);
+						}
+						return true;
+					});
+					react_ahead(e, statics, delegates, ListenerPriority::LAST);
+					return;
+				}
+				typename Reactors_t::Dispatch const d {self.rs};
+				auto const executor = parallel_executor();
+				for(auto it = d.begin(), end = d.end(); it != end; )
+				{
+					react_ahead(e, statics, delegates, it->priority);
+					auto const l = it->get();
+					if(executor && l && l->parallel_safe)
+					{
+						it = react_parallel(*executor, e, it, end);
+						continue;
+					}
+					if(l && reacts(e, *l))
+					{
+						impl::Span const span {impl::Span::REACTOR, l};
+						l->react(e);
+					}
+					++it;
+				}
+				react_ahead(e, statics, delegates, ListenerPriority::LAST);
+			}
+
+			//Reacts with only the reactor d refers to, and returns false without reacting at all
+			//if it is no longer listening here under the same handle
+			static bool react(Event_t const &e, DirectReactor const &d) noexcept(EventT::NOEXCEPT)
+			{
+				auto &self = Event_t::registrar();
+				if(d.owner != &self)
+				{
+					return false;
+				}
+				auto const keyed = d.key? self.krs.find(d.key) : nullptr;
+				if(d.key && !keyed)
+				{
+					return false;
+				}
+				auto &table = keyed? *keyed : self.rs;
+				//Entered first so that the reactor cannot finish ignoring until this returns
+				typename Reactors_t::Dispatch const dispatch {table};
+				auto const r = table.find(d.handle);
+				if(!r || static_cast<void *>(r) != d.reactor)
+				{
+					return false;
+				}
+#ifdef LB_EVENTS_METRICS
+				impl::Metrics::Metered const metered {self.m.react, 1};
+#endif
+#ifdef LB_EVENTS_TRACING
+				impl::Span const span {impl::Span::REACT, &self, self.name};
+#endif
+				if(reacts(e, *r))
+				{
+					impl::Span const span {impl::Span::REACTOR, r};
+					r->react(e);
+				}
+				return true;
+			}
+
+			//Reacts with the reactors which have not reacted according to c, in order, until stop
+			//returns true for the priority of the next one, and returns whether all of them have.
+			//Parallel reactors react one at a time.
+			template<typename StopT>
+			static bool react(Event_t const &e, impl::ReactCursor &c, StopT &stop) noexcept(EventT::NOEXCEPT)
+			{
+				if(c.finished)
+				{
+					return true;
+				}
+				auto &self = Event_t::registrar();
+#ifdef LB_EVENTS_METRICS
+				impl::Metrics::Metered const metered {self.m.react, c.entered? 0u : 1u};
+#endif
+#ifdef LB_EVENTS_TRACING
+				impl::Span const span {impl::Span::REACT, &self, self.name};
+#endif
+				if(!c.entered)
+				{
+					c.statics = first_static(e);
+				}
+				c.entered = true;
+				c.resume();
+				bool all = true;
+				impl::Delegates<DelegateReactors_t> delegates {self.drs, delegates_react(self, e)};
+				auto const statics = [&](Priority_t until)
+				{
+					Static_t::template visit<false>(c.statics, until, [&](auto l)
+					{
+						if(stop(l.priority))
+						{
+							return all = false;
+						}
+						impl::Span const span {impl::Span::REACTOR, nullptr};
+						l.call(e);
+						return true;
+					});
+					return all;
+				};
+				auto const ahead = [&](Priority_t until)
+				{
+					delegates.until(until, [&](Priority_t priority, auto const &d)
+					{
+						if(!statics(priority))
+						{
+							return false;
+						}
+						impl::ReactCursor::Id const id {d.context, reinterpret_cast<void (*)()>(d.function)};
+						if(c.reacted(priority, id))
+						{
+							return true;
+						}
+						if(stop(priority))
+						{
+							return all = false;
+						}
+						c.reacting(priority, id);
+						impl::Span const span {impl::Span::REACTOR, d.context};
+						d.function(d.context, e);
+						return true;
+					});
+					return all && statics(until);
+				};
+				auto const visit = [&](Priority_t priority, Reactor_t *l)
+				{
+					if(!l)
+					{
+						return true;
+					}
+					if(!ahead(priority))
+					{
+						return false;
+					}
+					if(c.reacted(priority, {l, nullptr}))
+					{
+						return true;
+					}
+					if(stop(priority))
+					{
+						return all = false;
+					}
+					c.reacting(priority, {l, nullptr});
+					if(reacts(e, *l))
+					{
+						impl::Span const span {impl::Span::REACTOR, l};
+						l->react(e);
+					}
+					return true;
+				};
+				if(auto const keyed = find(self.krs, e))
+				{
+					impl::merge(self.rs, *keyed, visit);
+				}
+				else
+				{
+					typename Reactors_t::Dispatch const d {self.rs};
+					for(auto const &r : d)
+					{
+						if(!visit(r.priority, r.get()))
+						{
+							break;
+						}
+					}
+				}
+				return c.finished = all && ahead(ListenerPriority::LAST);
+			}
+
+			//Each listener handles every event in [first, last) before the next listener runs
+			template<typename It>
+			static void process(It first, It last) noexcept(EventT::NOEXCEPT)
+			{
+				auto &self = Event_t::registrar();
+				if(!self.kps.empty())
+				{
+					//Each event may have different keyed processors
+					for(auto it = first; it != last; ++it)
+					{
+						process(*it);
+					}
+					return;
+				}
+#ifdef LB_EVENTS_METRICS
+				impl::Metrics::Metered const metered {self.m.process, static_cast<std::uint64_t>(std::distance(first, last))};
+#endif
+#ifdef LB_EVENTS_TRACING
+				impl::Span const span {impl::Span::PROCESS, &self, self.name};
+#endif
+				std::size_t statics = 0;
+				impl::Delegates<DelegateProcessors_t> delegates {self.dps};
+				typename Processors_t::Dispatch const d {self.ps};
+				for(auto const &p : d)
+				{
+					process_ahead(first, last, statics, delegates, p.priority);
+					for(auto it = first; it != last; ++it)
+					{
+						//Reloaded per event in case the processor stopped listening
+						auto const l = p.get();
+						if(!l)
+						{
+							break;
+						}
+						Event_t &e = *it;
+						if(!e.processing_stopped() && e.should_process(*l))
+						{
+							impl::Span const span {impl::Span::PROCESSOR, l};
+							l->process(e);
+						}
+					}
+				}
+				process_ahead(first, last, statics, delegates, ListenerPriority::LAST);
+			}
+			template<typename It>
+			static void react(It first, It last) noexcept(EventT::NOEXCEPT)
+			{
+				auto &self = Event_t::registrar();
+				if(!self.krs.empty())
+				{
+					//Each event may have different keyed reactors
+					for(auto it = first; it != last; ++it)
+					{
+						react(*it);
+					}
+					return;
+				}
+#ifdef LB_EVENTS_METRICS
+				impl::Metrics::Metered const metered {self.m.react, static_cast<std::uint64_t>(std::distance(first, last))};
+#endif
+#ifdef LB_EVENTS_TRACING
+				impl::Span const span {impl::Span::REACT, &self, self.name};
+#endif
+				std::size_t statics = 0;
+				impl::Delegates<DelegateReactors_t> delegates {self.drs};
+				typename Reactors_t::Dispatch const d {self.rs};
+				for(auto const &r : d)
+				{
+					react_ahead(first, last, statics, delegates, r.priority);
+					for(auto it = first; it != last; ++it)
+					{
+						//Reloaded per event in case the reactor stopped listening
+						auto const l = r.get();
+						if(!l)
+						{
+							break;
+						}
+						Event_t const &e = *it;
+						if(reacts(e, *l))
+						{
+							impl::Span const span {impl::Span::REACTOR, l};
+							l->react(e);
+						}
+					}
+				}
+				react_ahead(first, last, statics, delegates, ListenerPriority::LAST);
+			}
+
+		private:
+			using Static_t = StaticListeners<EventT>;
+			using DelegateProcessors_t = impl::ListenerTable_t<impl::Delegate<typename DelegateProcessor_t::Function_t> const>;
+			using DelegateReactors_t = impl::ListenerTable_t<impl::Delegate<typename DelegateReactor_t::Function_t> const>;
+
+			//Call the static listeners and delegates whose priority is at most until and which
+			//have not been called yet, static listeners first when equal. They run ahead of the
+			//other listeners of the same priority.
+			static void process_ahead(Event_t &e, std::size_t &statics, impl::Delegates<DelegateProcessors_t> &delegates, Priority_t until) noexcept(EventT::NOEXCEPT)
+			{
+				delegates.until(until, [&](Priority_t priority, auto const &d)
+				{
+					process_static(e, statics, priority);
+					if(e.processing_stopped())
+					{
+						return false;
+					}
+					impl::Span const span {impl::Span::PROCESSOR, d.context};
+					d.function(d.context, e);
+					return true;
+				});
+				process_static(e, statics, until);
+			}
+			static void react_ahead(Event_t const &e, std::size_t &statics, impl::Delegates<DelegateReactors_t> &delegates, Priority_t until) noexcept(EventT::NOEXCEPT)
+			{
+				delegates.until(until, [&](Priority_t priority, auto const &d)
+				{
+					react_static(e, statics, priority);
+					impl::Span const span {impl::Span::REACTOR, d.context};
+					d.function(d.context, e);
+					return true;
+				});
+				react_static(e, statics, until);
+			}
+			template<typename It>
+			static void process_ahead(It first, It last, std::size_t &statics, impl::Delegates<DelegateProcessors_t> &delegates, Priority_t until) noexcept(EventT::NOEXCEPT)
+			{
+				delegates.until(until, [&](Priority_t priority, auto const &d)
+				{
+					process_static(first, last, statics, priority);
+					for(auto it = first; it != last; ++it)
+					{
+						Event_t &e = *it;
+						if(!e.processing_stopped())
+						{
+							impl::Span const span {impl::Span::PROCESSOR, d.context};
+							d.function(d.context, e);
+						}
+					}
+					return true;
+				});
+				process_static(first, last, statics, until);
+			}
+			template<typename It>
+			static void react_ahead(It first, It last, std::size_t &statics, impl::Delegates<DelegateReactors_t> &delegates, Priority_t until) noexcept(EventT::NOEXCEPT)
+			{
+				delegates.until(until, [&](Priority_t priority, auto const &d)
+				{
+					react_static(first, last, statics, priority);
+					for(auto it = first; it != last; ++it)
+					{
+						impl::Span const span {impl::Span::REACTOR, d.context};
+						d.function(d.context, static_cast<Event_t const &>(*it));
+					}
+					return true;
+				});
+				react_static(first, last, statics, until);
+			}
+			//Call the static listeners from index next on whose priority is at most until
+			static void process_static(Event_t &e, std::size_t &next, Priority_t until) noexcept(EventT::NOEXCEPT)
+			{
+				Static_t::template visit<true>(next, until, [&](auto l)
+				{
+					if(e.processing_stopped())
+					{
+						return false;
+					}
+					impl::Span const span {impl::Span::PROCESSOR, nullptr};
+					l.call(e);
+					return true;
+				});
+			}
+			static void react_static(Event_t const &e, std::size_t &next, Priority_t until) noexcept(EventT::NOEXCEPT)
+			{
+				Static_t::template visit<false>(next, until, [&](auto l)
+				{
+					impl::Span const span {impl::Span::REACTOR, nullptr};
+					l.call(e);
+					return true;
+				});
+			}
+			template<typename It>
+			static void process_static(It first, It last, std::size_t &next, Priority_t until) noexcept(EventT::NOEXCEPT)
+			{
+				Static_t::template visit<true>(next, until, [&](auto l)
+				{
+					for(auto it = first; it != last; ++it)
+					{
+						Event_t &e = *it;
+						if(!e.processing_stopped())
+						{
+							impl::Span const span {impl::Span::PROCESSOR, nullptr};
+							l.call(e);
+						}
+					}
+					return true;
+				});
+			}
+			template<typename It>
+			static void react_static(It first, It last, std::size_t &next, Priority_t until) noexcept(EventT::NOEXCEPT)
+			{
+				Static_t::template visit<false>(next, until, [&](auto l)
+				{
+					for(auto it = first; it != last; ++it)
+					{
+						impl::Span const span {impl::Span::REACTOR, nullptr};
+						l.call(static_cast<Event_t const &>(*it));
+					}
+					return true;
+				});
+			}
+
+			friend typename Event_t::Implementor_t;
+#if defined(LB_EVENTS_METRICS) || defined(LB_EVENTS_TRACING)
+			Registrar(char const *name) noexcept
+#ifdef LB_EVENTS_METRICS
+			: m{name, this,
+				[](void const *r) noexcept { auto const &self = *static_cast<Registrar const *>(r); return Static_t::PROCESSORS + self.ps.size() + self.kps.size() + self.dps.size(); },
+				[](void const *r) noexcept { auto const &self = *static_cast<Registrar const *>(r); return Static_t::REACTORS + self.rs.size() + self.krs.size() + self.drs.size(); }}
+#endif
+			{
+#ifdef LB_EVENTS_TRACING
+				this->name = name;
+#endif
+			}
+#else
+			Registrar() = default;
+#endif
+
+			//Where the static reactors of e start, which is past all of them if e chooses its
+			//reactors, since static reactors have no listener object to offer should_react()
+			static auto first_static(Event_t const &e) noexcept
+			-> std::size_t
+			{
+				return Static_t::REACTORS != 0 && e.chooses_reactors()? Static_t::LISTENERS : 0;
+			}
+			//Whether the delegate reactors react to e, which like static reactors they do not if e
+			//chooses its reactors
+			static bool delegates_react(Registrar const &self, Event_t const &e) noexcept
+			{
+				return !self.drs.empty() && !e.chooses_reactors();
+			}
+			//Whether r reacts to e: e does not filter it out and its Sampling picks e
+			static bool reacts(Event_t const &e, Reactor_t &r) noexcept
+			{
+				return e.should_react(r) && r.sampler.take();
+			}
+			//Hands the run of parallel reactors starting at first with its priority to the executor
+			template<typename It>
+			static auto react_parallel(ParallelExecutor &executor, Event_t const &e, It first, It end)
+			-> It
+			{
+				std::vector<decltype(&*first)> run;
+				auto last = first;
+				while(last != end && last->priority == first->priority)
+				{
+					auto const l = last->get();
+					if(l && !l->parallel_safe)
+					{
+						break;
+					}
+					run.push_back(&*last);
+					++last;
+				}
+				if(run.size() == 1)
+				{
+					auto const l = first->get();
+					if(reacts(e, *l))
+					{
+						impl::Span const span {impl::Span::REACTOR, l};
+						l->react(e);
+					}
+					return last;
+				}
+				struct Context final
+				{
+					Event_t const &e;
+					std::vector<decltype(&*first)> const &run;
+					impl::Registrars *domain;
+				} context {e, run, impl::current_registrars()};
+				executor.run(run.size(), [](void *c, std::size_t i)
+				{
+					auto const &context = *static_cast<Context *>(c);
+					//Whatever the reactor calls or listens to stays in the caller's EventDomain
+					impl::CurrentRegistrars const domain {context.domain};
+					auto const l = context.run[i]->get();
+					if(l && reacts(context.e, *l))
+					{
+						impl::Span const span {impl::Span::REACTOR, l};
+						l->react(context.e);
+					}
+				}, &context);
+				return last;
+			}
+
+			using Processors_t = impl::ListenerTable_t<Processor_t const>;
+			using Reactors_t = impl::ListenerTable_t<Reactor_t>;
+			Processors_t ps;
+			Reactors_t rs;
+			impl::KeyedListenerTable<Processor_t const> kps;
+			impl::KeyedListenerTable<Reactor_t> krs;
+			DelegateProcessors_t dps;
+			DelegateReactors_t drs;
+			impl::Levels pl;
+			impl::Levels rl;
+#ifdef LB_EVENTS_METRICS
+			impl::Metrics m;
+#endif
+#ifdef LB_EVENTS_TRACING
+			char const *name = nullptr; //the event type, for trace spans
+#endif
+			//The table of listeners for the key of e, if there is one
+			template<typename KeyedT>
+			static auto find(KeyedT const &keyed, Event_t const &e) noexcept
+			-> decltype(keyed.find(ListenerKey{}))
+			{
+				if(keyed.empty())
+				{
+					return nullptr;
+				}
+				auto const key = e.key();
+				return key? keyed.find(key) : nullptr;
+			}
+		};
+
+		namespace impl
+		{
+			template<typename T, typename...>
+			struct Unwrapper;
+			template<typename T, typename First, typename... Rest>
+			struct Unwrapper<T, First, Rest...> final
+			{
+				static_assert(std::is_base_of<Event, First>::value, "ParentT must derive from Event");
+				using Next = Unwrapper<T, Rest...>;
+				using LevelT = First;
+				static constexpr std::size_t LEVELS = 1 + Next::LEVELS;
+				Unwrapper() = delete;
+				//The index of First in T::Hierarchy_t
+				static constexpr auto LEVEL() noexcept
+				-> std::size_t
+				{
+					return T::Hierarchy_t::LEVELS - LEVELS;
+				}
+				//Each level is visited only if levels says it has listeners
+				static void process(T &t, Levels &levels) noexcept(T::NOEXCEPT)
+				{
+					if(levels.template visit<LevelT, true>(LEVEL()))
+					{
+						First::Registrar_t::process(t);
+					}
+					Next::process(t, levels);
+				}
+				static void react(T const &t, Levels &levels) noexcept(T::NOEXCEPT)
+				{
+					if(levels.template visit<LevelT, false>(LEVEL()))
+					{
+						First::Registrar_t::react(t);
+					}
+					Next::react(t, levels);
+				}
+				//Whether the level d reacts to still has it
+				static bool react(T const &t, DirectReactor const &d) noexcept(T::NOEXCEPT)
+				{
+					return d.is<First>()? First::Registrar_t::react(t, d) : Next::react(t, d);
+				}
+				//c holds a cursor for each of the LEVELS registrars; every level gets its turn
+				template<typename StopT>
+				static bool react(T const &t, Levels &levels, ReactCursor *c, StopT &stop) noexcept(T::NOEXCEPT)
+				{
+					bool const done = !levels.template visit<LevelT, false>(LEVEL()) || First::Registrar_t::react(t, *c, stop);
+					return Next::react(t, levels, c + 1, stop) && done;
+				}
+				template<typename It>
+				static void process(It first, It last, Levels &levels) noexcept(T::NOEXCEPT)
+				{
+					if(levels.template visit<LevelT, true>(LEVEL()))
+					{
+						First::Registrar_t::process(first, last);
+					}
+					Next::process(first, last, levels);
+				}
+				template<typename It>
+				static void react(It first, It last, Levels &levels) noexcept(T::NOEXCEPT)
+				{
+					if(levels.template visit<LevelT, false>(LEVEL()))
+					{
+						First::Registrar_t::react(first, last);
+					}
+					Next::react(first, last, levels);
+				}
+				static auto parents(T &t) noexcept
+				{
+					return tuple_cat(tuples::tuple<First &>{t}, Next::parents(t));
+				}
+				static auto parents(T const &t) noexcept
+				{
+					return tuple_cat(tuples::tuple<First const &>{t}, Next::parents(t));
+				}
+				using all_parents_t = typename tuples::tuple_type_cat
+				<
+					typename First::Unwrapper_t::all_parents_t,
+					typename Rest::Unwrapper_t::all_parents_t...,
+					tuples::tuple<First>,
+					typename Next::all_parents_t
+				>::type;
+			};
+			template<typename T>
+			struct Unwrapper<T> final
+			{
+				using LevelT = T;
+				static constexpr std::size_t LEVELS = 1;
+				Unwrapper() = delete;
+				static constexpr auto LEVEL() noexcept
+				-> std::size_t
+				{
+					return T::Hierarchy_t::LEVELS - 1;
+				}
+				//Implementor is always a non-virtual base of its event
+				static void process(T &t, Levels &levels) noexcept(T::NOEXCEPT)
+				{
+					static_assert(std::is_base_of<Event, typename T::Event_t>::value, "Only Event can be root");
+					if(levels.template visit<LevelT, true>(LEVEL()))
+					{
+						T::Registrar_t::process(static_cast<typename T::Event_t &>(t));
+					}
+				}
+				static void react(T const &t, Levels &levels) noexcept(T::NOEXCEPT)
+				{
+					static_assert(std::is_base_of<Event, typename T::Event_t>::value, "Only Event can be root");
+					if(levels.template visit<LevelT, false>(LEVEL()))
+					{
+						T::Registrar_t::react(static_cast<typename T::Event_t const &>(t));
+					}
+				}
+				static bool react(T const &t, DirectReactor const &d) noexcept(T::NOEXCEPT)
+				{
+					return d.is<typename T::Event_t>() && T::Registrar_t::react(static_cast<typename T::Event_t const &>(t), d);
+				}
+				template<typename StopT>
+				static bool react(T const &t, Levels &levels, ReactCursor *c, StopT &stop) noexcept(T::NOEXCEPT)
+				{
+					return !levels.template visit<LevelT, false>(LEVEL()) || T::Registrar_t::react(static_cast<typename T::Event_t const &>(t), *c, stop);
+				}
+				template<typename It>
+				static void process(It first, It last, Levels &levels) noexcept(T::NOEXCEPT)
+				{
+					if(levels.template visit<LevelT, true>(LEVEL()))
+					{
+						T::Registrar_t::process(first, last);
+					}
+				}
+				template<typename It>
+				static void react(It first, It last, Levels &levels) noexcept(T::NOEXCEPT)
+				{
+					if(levels.template visit<LevelT, false>(LEVEL()))
+					{
+						T::Registrar_t::react(first, last);
+					}
+				}
+				static auto parents(T &t) noexcept
 				-> tuples::tuple<>
 				{
 					return {};
@@ -404,14 +3381,26 @@ namespace LB
 			static constexpr bool NOEXCEPT = Inheriter_t::NOEXCEPT;
 			virtual ~Implementor() noexcept = 0;
 
-			static void listen(Processor_t const &p, ListenerPriority priority = ListenerPriority{}) noexcept
+			static auto listen(Processor_t const &p, ListenerPriority priority = ListenerPriority{}) noexcept
+			-> ListenerHandle
 			{
 				return Registrar_t::listen(p, priority);
 			}
-			static void listen(Reactor_t &r, ListenerPriority priority = ListenerPriority{}) noexcept
+			static auto listen(Reactor_t &r, ListenerPriority priority = ListenerPriority{}) noexcept
+			-> ListenerHandle
 			{
 				return Registrar_t::listen(r, priority);
 			}
+			static auto listen(Processor_t const &p, ListenerKey key, ListenerPriority priority = ListenerPriority{}) noexcept
+			-> ListenerHandle
+			{
+				return Registrar_t::listen(p, key, priority);
+			}
+			static auto listen(Reactor_t &r, ListenerKey key, ListenerPriority priority = ListenerPriority{}) noexcept
+			-> ListenerHandle
+			{
+				return Registrar_t::listen(r, key, priority);
+			}
 
 			static void ignore(Processor_t const &p) noexcept
 			{
@@ -422,35 +3411,50 @@ namespace LB
 				return Registrar_t::ignore(r);
 			}
 
-			virtual void process() noexcept(NOEXCEPT) override
+			static bool listening(Processor_t const &p) noexcept
+			{
+				return Registrar_t::listening(p);
+			}
+			static bool listening(Reactor_t const &r) noexcept
 			{
-				tuples::tuple_template_forward
+				return Registrar_t::listening(r);
+			}
+
+			//Visits the registrar of every class in the hierarchy exactly once, least derived first,
+			//skipping those without listeners for the phase (see impl::Levels). Parents are reached
+			//by implicit upcasts and this event by a static downcast, so calling an event costs no
+			//RTTI and only one virtual call per phase.
+			using Hierarchy_t = typename tuples::tuple_template_forward
+			<
+				impl::Unwrapper,
+				typename tuples::tuple_type_cat
 				<
-					impl::Unwrapper,
-					typename tuples::tuple_type_cat
+					tuples::tuple<Implementor_t>,
+					typename tuples::tuple_prune
 					<
-						tuples::tuple<Implementor_t>,
-						typename tuples::tuple_prune
-						<
-							typename Unwrapper_t::all_parents_t
-						>::type
+						typename Unwrapper_t::all_parents_t
 					>::type
-				>::type::process(*this);
+				>::type
+			>::type;
+
+			virtual void process() noexcept(NOEXCEPT) override
+			{
+				Hierarchy_t::process(*this, Registrar_t::template levels<true>());
 			}
 			virtual void react() const noexcept(NOEXCEPT) override
 			{
-				tuples::tuple_template_forward
-				<
-					impl::Unwrapper,
-					typename tuples::tuple_type_cat
-					<
-						tuples::tuple<Implementor_t>,
-						typename tuples::tuple_prune
-						<
-							typename Unwrapper_t::all_parents_t
-						>::type
-					>::type
-				>::type::react(*this);
+				auto const &e = static_cast<Event_t const &>(*this);
+				//One check for the whole hierarchy, however many reactors are listening
+				if(!e.reactable())
+				{
+					return;
+				}
+				//A direct reactor which has since stopped listening is looked for the usual way
+				auto const d = e.direct_reactor();
+				if(!d || !Hierarchy_t::react(*this, d))
+				{
+					Hierarchy_t::react(*this, Registrar_t::template levels<false>());
+				}
 			}
 
 		private:
@@ -462,7 +3466,7 @@ namespace LB
 			static Registrar_t &registrar() noexcept;
 		};
 		template<typename EventT, template<typename...> typename InheriterT, typename... ParentT>
-		Implementor<EventT, InheriterT<ParentT...>>::~Implementor<EventT, InheriterT<ParentT...>>() noexcept = default;
+		Implementor<EventT, InheriterT<ParentT...>>::~Implementor() noexcept = default;
 		template<typename EventT, typename... ParentT>
 		struct Implementor
 		: Implementor<EventT, impl::Inheriter<ParentT...>>
@@ -475,7 +3479,7 @@ namespace LB
 			Implementor() noexcept = default;
 		};
 		template<typename EventT, typename... ParentT>
-		Implementor<EventT, ParentT...>::~Implementor<EventT, ParentT...>() noexcept = default;
+		Implementor<EventT, ParentT...>::~Implementor() noexcept = default;
 
 		template<typename EventT, typename... ParentT>
 		auto parents(Implementor<EventT, ParentT...> &e) noexcept
@@ -489,9 +3493,68 @@ namespace LB
 		{
 			return std::remove_reference<decltype(e)>::type::Unwrapper_t::parents(e);
 		}
+
+		namespace impl
+		{
+			template<typename It>
+			using RangeEvent_t = typename std::remove_cv
+			<
+				typename std::remove_reference<decltype(*std::declval<It &>())>::type
+			>::type;
+		}
+		//Batch dispatch for a range of events which are all of the same type.
+		//Each listener handles the whole range before the next listener runs, so every event is
+		//processed before any of them is reacted to, and each reactor sees the events in order.
+		template<typename It>
+		void process(It first, It last) noexcept(impl::RangeEvent_t<It>::NOEXCEPT)
+		{
+			using Event_t = impl::RangeEvent_t<It>;
+			Event_t::Hierarchy_t::process(first, last, Event_t::Registrar_t::template levels<true>());
+		}
+		//Events which are not reactable are left out of the batch, and those with a DirectReactor
+		//or which choose their reactors react on their own, in order, once the rest of the batch has
+		template<typename It>
+		void react(It first, It last) noexcept(impl::RangeEvent_t<It>::NOEXCEPT)
+		{
+			using Event_t = impl::RangeEvent_t<It>;
+			auto const batched = [](Event_t const &e) noexcept
+			{
+				return e.reactable() && !e.direct_reactor() && !e.chooses_reactors();
+			};
+			auto &levels = Event_t::Registrar_t::template levels<false>();
+			auto const mixed = std::find_if_not(first, last, batched);
+			if(mixed == last)
+			{
+				Event_t::Hierarchy_t::react(first, last, levels);
+				return;
+			}
+			std::vector<std::reference_wrapper<Event_t const>> batch (first, mixed);
+			std::copy_if(mixed, last, std::back_inserter(batch), batched);
+			Event_t::Hierarchy_t::react(batch.begin(), batch.end(), levels);
+			for(auto it = mixed; it != last; ++it)
+			{
+				Event_t const &e = *it;
+				if(!batched(e) && e.reactable())
+				{
+					e.react();
+				}
+			}
+		}
+		template<typename It>
+		void call(It first, It last) noexcept(impl::RangeEvent_t<It>::NOEXCEPT)
+		{
+			impl::Span const span {impl::Span::CALL, nullptr};
+			process(first, last);
+			react(first, last);
+		}
 	}
 }
 
+#if defined(LB_EVENTS_METRICS) || defined(LB_EVENTS_TRACING)
+#define LB_EVENTS_IMPL_NAME(E) #E
+#else
+#define LB_EVENTS_IMPL_NAME(E)
+#endif
 //Necessary evil is necessary
 #define LB_EVENTS_EVENT(E) \
 	namespace LB \
@@ -502,7 +3565,12 @@ namespace LB
 			auto E::Implementor_t::registrar() noexcept \
 			-> Registrar_t & \
 			{ \
-				static Registrar_t r; \
+				if(auto const d = impl::current_registrars()) \
+				{ \
+					static std::size_t const index = impl::next_type_index(); \
+					return d->get<Registrar_t>(index, []{ return new Registrar_t{LB_EVENTS_IMPL_NAME(E)}; }); \
+				} \
+				static Registrar_t r {LB_EVENTS_IMPL_NAME(E)}; \
 				return r; \
 			} \
 		} \
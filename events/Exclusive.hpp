@@ -16,6 +16,15 @@ namespace LB
 			virtual void claim(Claim_t r) noexcept
 			{
 				c = r;
+				direct = {};
+			}
+			//Also lets react() call r directly instead of asking every reactor should_react(), as
+			//long as r still listens under the handle it had when claimed
+			template<typename EventT>
+			void claim(Reactor<EventT> &r) noexcept
+			{
+				claim(static_cast<Claim_t>(std::addressof(r)));
+				direct = r;
 			}
 			virtual Claim_t claim() const noexcept final
 			{
@@ -26,9 +35,23 @@ namespace LB
 			{
 				return std::addressof(r) == c;
 			}
+			virtual bool reactable() const noexcept override
+			{
+				return c != nullptr;
+			}
+			virtual bool chooses_reactors() const noexcept override
+			{
+				return true;
+			}
+			virtual auto direct_reactor() const noexcept
+			-> DirectReactor override
+			{
+				return direct;
+			}
 
 		private:
 			Claim_t c {};
+			DirectReactor direct;
 		};
 		inline Exclusive::~Exclusive() = default;
 	}
@@ -0,0 +1,210 @@
+#include "Journal.hpp"
+
+#include <chrono>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+LB_EVENTS_EVENT(LB::events::Journaled);
+
+namespace LB
+{
+	namespace events
+	{
+		namespace
+		{
+			constexpr char MAGIC[8] = {'L', 'B', 'e', 'v', 'J', 'n', 'l', '1'};
+
+			struct Header final
+			{
+				std::int64_t ns;
+				Journaled::Type_t type;
+				std::uint32_t size;
+			};
+
+			auto now() noexcept
+			-> std::int64_t
+			{
+				return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+			}
+			[[noreturn]] void fail(char const *what)
+			{
+				throw std::system_error{errno, std::system_category(), what};
+			}
+		}
+
+		void JournalReader::read(void *out, std::size_t size)
+		{
+			if(size > left)
+			{
+				throw std::out_of_range{"read past the end of a journal record"};
+			}
+			std::memcpy(out, data, size);
+			data += size;
+			left -= size;
+		}
+
+		Journal::Journal(std::string const &path, std::size_t initial_size)
+		: Processor<Journaled>(ListenLater{})
+		, fd{::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)}
+		, start{now()}
+		{
+			if(fd < 0)
+			{
+				fail("open");
+			}
+			try
+			{
+				reserve(initial_size < sizeof(MAGIC)? sizeof(MAGIC) : initial_size);
+			}
+			catch(...)
+			{
+				::close(fd);
+				throw;
+			}
+			write(MAGIC, sizeof(MAGIC));
+			listen(ListenerPriority::FIRST);
+		}
+		Journal::~Journal() noexcept
+		{
+			ignore();
+			::munmap(map, mapped);
+			if(::ftruncate(fd, static_cast<off_t>(length)) != 0)
+			{
+				//Nothing more can be done; the tail of the file is zeros
+			}
+			::close(fd);
+		}
+
+		auto Journal::size() const noexcept
+		-> std::size_t
+		{
+			std::lock_guard<std::mutex> const lock {m};
+			return length;
+		}
+
+		void Journal::process(Journaled &e) const
+		{
+			//Recording is not application state, so it is fine to do while processing
+			auto &self = const_cast<Journal &>(*this);
+			std::lock_guard<std::mutex> const lock {m};
+			auto const at = length;
+			Header const h {now() - start, e.journal_type(), 0};
+			try
+			{
+				self.write(&h, sizeof(h));
+				e.save(self);
+			}
+			catch(...)
+			{
+				//Leave no partial record behind for replay to trip over
+				std::memset(map + at, 0, length - at);
+				self.length = at;
+				throw;
+			}
+			auto const size = static_cast<std::uint32_t>(length - at - sizeof(h));
+			std::memcpy(map + at + offsetof(Header, size), &size, sizeof(size));
+		}
+		void Journal::write(void const *data, std::size_t size)
+		{
+			reserve(length + size);
+			std::memcpy(map + length, data, size);
+			length += size;
+		}
+		void Journal::reserve(std::size_t size)
+		{
+			if(size <= mapped)
+			{
+				return;
+			}
+			auto grown = mapped? mapped : size;
+			while(grown < size)
+			{
+				grown *= 2;
+			}
+			if(::ftruncate(fd, static_cast<off_t>(grown)) != 0)
+			{
+				fail("ftruncate");
+			}
+			if(map)
+			{
+				::munmap(map, mapped);
+				map = nullptr;
+				mapped = 0;
+			}
+			void *p = ::mmap(nullptr, grown, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			if(p == MAP_FAILED)
+			{
+				fail("mmap");
+			}
+			map = static_cast<unsigned char *>(p);
+			mapped = grown;
+		}
+
+		JournalReplay::JournalReplay(std::string const &path)
+		{
+			int const fd = ::open(path.c_str(), O_RDONLY);
+			if(fd < 0)
+			{
+				fail("open");
+			}
+			struct stat st;
+			if(::fstat(fd, &st) != 0)
+			{
+				::close(fd);
+				fail("fstat");
+			}
+			length = static_cast<std::size_t>(st.st_size);
+			void *p = length? ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+			::close(fd);
+			if(p == MAP_FAILED || std::memcmp(p, MAGIC, sizeof(MAGIC)) != 0)
+			{
+				if(p != MAP_FAILED)
+				{
+					::munmap(p, length);
+				}
+				throw std::runtime_error{"not an event journal: " + path};
+			}
+			map = static_cast<unsigned char const *>(p);
+		}
+		JournalReplay::~JournalReplay() noexcept
+		{
+			::munmap(const_cast<unsigned char *>(map), length);
+		}
+
+		auto JournalReplay::replay(bool realtime)
+		-> std::size_t
+		{
+			std::size_t n = 0;
+			auto const begin = std::chrono::steady_clock::now();
+			for(std::size_t at = sizeof(MAGIC); at + sizeof(Header) <= length; )
+			{
+				Header h;
+				std::memcpy(&h, map + at, sizeof(h));
+				at += sizeof(h);
+				if(h.size > length - at)
+				{
+					throw std::runtime_error{"truncated event journal"};
+				}
+				auto const l = loaders.find(h.type);
+				if(l != loaders.end())
+				{
+					if(realtime)
+					{
+						std::this_thread::sleep_until(begin + std::chrono::nanoseconds{h.ns});
+					}
+					JournalReader r {map + at, h.size};
+					l->second(r);
+					++n;
+				}
+				at += h.size;
+			}
+			return n;
+		}
+	}
+}
@@ -0,0 +1,159 @@
+#ifndef LB_events_Journal_HeaderPlusPlus
+#define LB_events_Journal_HeaderPlusPlus
+
+#include "Event.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+namespace LB
+{
+	namespace events
+	{
+		//Appends to a Journal
+		struct JournalWriter
+		{
+			virtual void write(void const *data, std::size_t size) = 0;
+
+			template<typename T>
+			void write(T const &t)
+			{
+				static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+				write(std::addressof(t), sizeof(T));
+			}
+
+		protected:
+			~JournalWriter() = default;
+		};
+		//Reads back what a JournalWriter wrote, throwing std::out_of_range past the end of the record
+		struct JournalReader final
+		{
+			JournalReader(unsigned char const *data, std::size_t size) noexcept
+			: data{data}
+			, left{size}
+			{
+			}
+
+			void read(void *out, std::size_t size);
+
+			template<typename T>
+			auto read()
+			-> T
+			{
+				static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+				T t;
+				read(std::addressof(t), sizeof(T));
+				return t;
+			}
+
+		private:
+			unsigned char const *data;
+			std::size_t left;
+		};
+
+		//The base class for events which can be recorded by a Journal. Besides overriding save(),
+		//the event type must have
+		//  static constexpr Journaled::Type_t JOURNAL_TYPE = /*an id unique among your events*/;
+		//  static auto load(LB::events::JournalReader &r) -> /*the event type*/;
+		//where load() rebuilds the event from what save() wrote, and also derive from
+		//JournalType to implement journal_type() from JOURNAL_TYPE.
+		struct Journaled
+		: Implementor<Journaled, Event>
+		{
+			using Type_t = std::uint32_t;
+			virtual ~Journaled() = 0;
+
+			virtual auto journal_type() const noexcept
+			-> Type_t = 0;
+			virtual void save(JournalWriter &w) const = 0;
+		};
+		inline Journaled::~Journaled() = default;
+		//Implements journal_type() as EventT::JOURNAL_TYPE, so that the two cannot disagree:
+		//  struct Order : Implementor<Order, Journaled>, JournalType<Order> { /**/ };
+		//It is not a class of the event's hierarchy and needs no listeners of its own.
+		template<typename EventT>
+		struct JournalType
+		: virtual Journaled
+		{
+			virtual auto journal_type() const noexcept
+			-> Type_t override final
+			{
+				static_assert(std::is_same<decltype(EventT::JOURNAL_TYPE), Type_t const>::value, "EventT::JOURNAL_TYPE must be a Journaled::Type_t");
+				return EventT::JOURNAL_TYPE;
+			}
+		};
+
+		//Records every Journaled event as it is called, before any of its processors run (other
+		//than those of Event itself), to an append-only memory-mapped file. Each record is the
+		//time since the journal was opened, the event's type, and what it saved.
+		struct Journal final
+		: private Processor<Journaled>
+		, private JournalWriter
+		{
+			//Creates or truncates the file at path
+			explicit Journal(std::string const &path, std::size_t initial_size = 1 << 20);
+			Journal(Journal const &) = delete;
+			Journal &operator=(Journal const &) = delete;
+			Journal(Journal &&) = delete;
+			Journal &operator=(Journal &&) = delete;
+			//Trims the file to what was recorded
+			~Journal() noexcept;
+
+			//The number of bytes recorded so far
+			auto size() const noexcept
+			-> std::size_t;
+
+		private:
+			int fd;
+			unsigned char *map = nullptr;
+			std::size_t mapped = 0;
+			std::size_t length = 0;
+			std::int64_t const start;
+			mutable std::mutex m;
+
+			virtual void process(Journaled &e) const override;
+			virtual void write(void const *data, std::size_t size) override;
+			void reserve(std::size_t size);
+		};
+
+		//Calls the events recorded by a Journal again, through the usual listeners. Only the
+		//event types passed to load<>() are called; the others are skipped.
+		struct JournalReplay final
+		{
+			explicit JournalReplay(std::string const &path);
+			JournalReplay(JournalReplay const &) = delete;
+			JournalReplay &operator=(JournalReplay const &) = delete;
+			JournalReplay(JournalReplay &&) = delete;
+			JournalReplay &operator=(JournalReplay &&) = delete;
+			~JournalReplay() noexcept;
+
+			template<typename EventT>
+			void load()
+			{
+				static_assert(std::is_base_of<Journaled, EventT>::value, "EventT must derive from Journaled");
+				loaders[EventT::JOURNAL_TYPE] = [](JournalReader &r)
+				{
+					EventT::load(r).call();
+				};
+			}
+
+			//Returns the number of events called. With realtime, waits between events as long as
+			//was recorded between them, otherwise calls them as fast as possible.
+			auto replay(bool realtime = false)
+			-> std::size_t;
+
+		private:
+			using Loader_t = void (*)(JournalReader &r);
+			std::unordered_map<Journaled::Type_t, Loader_t> loaders;
+			unsigned char const *map = nullptr;
+			std::size_t length = 0;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,165 @@
+#include "Parallel.hpp"
+
+#include <algorithm>
+
+namespace LB
+{
+	namespace events
+	{
+		namespace
+		{
+			thread_local WorkStealingPool const *current_pool = nullptr;
+			thread_local std::size_t current_worker = 0;
+		}
+
+		WorkStealingPool::WorkStealingPool(std::size_t threads)
+		{
+			threads = std::max<std::size_t>(threads, 1);
+			for(std::size_t i = 0; i < threads; ++i)
+			{
+				workers.emplace_back(new Worker);
+			}
+			for(std::size_t i = 0; i < threads; ++i)
+			{
+				workers[i]->thread = std::thread{[this, i]{ work(i); }};
+			}
+		}
+		WorkStealingPool::~WorkStealingPool() noexcept
+		{
+			{
+				std::lock_guard<std::mutex> const lock {sleep};
+				stopping = true;
+			}
+			wake.notify_all();
+			for(auto &w : workers)
+			{
+				w->thread.join();
+			}
+		}
+
+		void WorkStealingPool::run(std::size_t n, Task_t task, void *context)
+		{
+			if(n == 0)
+			{
+				return;
+			}
+			Batch batch {task, context, {n}, {}, {}};
+			auto const me = self();
+			if(me < workers.size())
+			{
+				std::lock_guard<std::mutex> const lock {workers[me]->m};
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					workers[me]->tasks.push_back(Task{&batch, i});
+				}
+			}
+			else
+			{
+				auto const first = next.fetch_add(n);
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					auto &w = *workers[(first + i) % workers.size()];
+					std::lock_guard<std::mutex> const lock {w.m};
+					w.tasks.push_back(Task{&batch, i});
+				}
+			}
+			queued.fetch_add(n);
+			{
+				std::lock_guard<std::mutex> const lock {sleep};
+			}
+			wake.notify_all();
+
+			while(batch.remaining.load(std::memory_order_acquire) != 0)
+			{
+				Task t;
+				if(take(me, t))
+				{
+					execute(t);
+				}
+				else
+				{
+					std::this_thread::yield();
+				}
+			}
+			if(batch.error)
+			{
+				std::rethrow_exception(batch.error);
+			}
+		}
+
+		auto WorkStealingPool::self() const noexcept
+		-> std::size_t
+		{
+			return current_pool == this ? current_worker : workers.size();
+		}
+		bool WorkStealingPool::take(std::size_t self, Task &t) noexcept
+		{
+			if(self < workers.size())
+			{
+				auto &w = *workers[self];
+				std::lock_guard<std::mutex> const lock {w.m};
+				if(!w.tasks.empty())
+				{
+					t = w.tasks.back();
+					w.tasks.pop_back();
+					queued.fetch_sub(1);
+					return true;
+				}
+			}
+			for(std::size_t i = 1; i <= workers.size(); ++i)
+			{
+				auto &w = *workers[(self + i) % workers.size()];
+				std::lock_guard<std::mutex> const lock {w.m};
+				if(!w.tasks.empty())
+				{
+					t = w.tasks.front();
+					w.tasks.pop_front();
+					queued.fetch_sub(1);
+					return true;
+				}
+			}
+			return false;
+		}
+		void WorkStealingPool::execute(Task const &t) noexcept
+		{
+			auto &batch = *t.batch;
+			try
+			{
+				batch.task(batch.context, t.i);
+			}
+			catch(...)
+			{
+				std::lock_guard<std::mutex> const lock {batch.m};
+				if(!batch.error)
+				{
+					batch.error = std::current_exception();
+				}
+			}
+			//Last touch: the batch may be gone as soon as this reaches zero
+			batch.remaining.fetch_sub(1, std::memory_order_release);
+		}
+		void WorkStealingPool::work(std::size_t self) noexcept
+		{
+			current_pool = this;
+			current_worker = self;
+			for(;;)
+			{
+				Task t;
+				if(take(self, t))
+				{
+					execute(t);
+					continue;
+				}
+				std::unique_lock<std::mutex> lock {sleep};
+				wake.wait(lock, [this]
+				{
+					return queued.load() != 0 || stopping;
+				});
+				if(stopping && queued.load() == 0)
+				{
+					return;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,73 @@
+#ifndef LB_events_Parallel_HeaderPlusPlus
+#define LB_events_Parallel_HeaderPlusPlus
+
+#include "Events.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace LB
+{
+	namespace events
+	{
+		//Each worker owns a deque of tasks, taking its own newest task first and otherwise
+		//stealing the oldest task of another worker. Threads waiting in run() help out too,
+		//so reactors may call events which use the same pool.
+		struct WorkStealingPool final
+		: ParallelExecutor
+		{
+			explicit WorkStealingPool(std::size_t threads = std::thread::hardware_concurrency());
+			WorkStealingPool(WorkStealingPool const &) = delete;
+			WorkStealingPool &operator=(WorkStealingPool const &) = delete;
+			WorkStealingPool(WorkStealingPool &&) = delete;
+			WorkStealingPool &operator=(WorkStealingPool &&) = delete;
+			virtual ~WorkStealingPool() noexcept;
+
+			//Rethrows the first exception thrown by a task once all of them have finished
+			virtual void run(std::size_t n, Task_t task, void *context) override;
+
+		private:
+			struct Batch final
+			{
+				Task_t task;
+				void *context;
+				std::atomic<std::size_t> remaining;
+				std::mutex m;
+				std::exception_ptr error;
+			};
+			struct Task final
+			{
+				Batch *batch;
+				std::size_t i;
+			};
+			struct Worker final
+			{
+				std::mutex m;
+				std::deque<Task> tasks;
+				std::thread thread;
+			};
+
+			std::vector<std::unique_ptr<Worker>> workers;
+			std::atomic<std::size_t> queued {0};
+			std::atomic<std::size_t> next {0};
+			bool stopping = false;
+			std::mutex sleep;
+			std::condition_variable wake;
+
+			auto self() const noexcept
+			-> std::size_t;
+			bool take(std::size_t self, Task &t) noexcept;
+			static void execute(Task const &t) noexcept;
+			void work(std::size_t self) noexcept;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,108 @@
+#include "Pipeline.hpp"
+
+namespace LB
+{
+	namespace events
+	{
+		Pipeline::Pipeline()
+		: dispatcher{[this]{ run(); }}
+		{
+		}
+		Pipeline::~Pipeline() noexcept
+		{
+			{
+				std::lock_guard<std::mutex> const lock {m};
+				stopping = true;
+			}
+			wake.notify_one();
+			dispatcher.join();
+		}
+
+		void Pipeline::flush() noexcept
+		{
+			auto const target = pushed.load();
+			while(reacted.load() < target)
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		void Pipeline::push(Node *n) noexcept
+		{
+			//Counted first so that flush() never stops short of an event queued before it
+			pushed.fetch_add(1);
+			n->next.store(nullptr, std::memory_order_relaxed);
+			head.exchange(n)->next.store(n, std::memory_order_release);
+			if(sleeping.load())
+			{
+				std::lock_guard<std::mutex> const lock {m};
+				wake.notify_one();
+			}
+		}
+		auto Pipeline::pop() noexcept
+		-> Node *
+		{
+			auto t = tail;
+			auto next = t->next.load(std::memory_order_acquire);
+			if(t == &stub)
+			{
+				if(!next)
+				{
+					return nullptr;
+				}
+				tail = t = next;
+				next = next->next.load(std::memory_order_acquire);
+			}
+			if(next)
+			{
+				tail = next;
+				return t;
+			}
+			if(t != head.load())
+			{
+				return nullptr; //a producer is part way through pushing
+			}
+			stub.next.store(nullptr, std::memory_order_relaxed);
+			head.exchange(&stub)->next.store(&stub, std::memory_order_release);
+			next = t->next.load(std::memory_order_acquire);
+			if(next)
+			{
+				tail = next;
+				return t;
+			}
+			return nullptr;
+		}
+		void Pipeline::run() noexcept
+		{
+			for(;;)
+			{
+				if(auto const n = pop())
+				{
+					{
+						EventDomain::Scope const scope {n->domain};
+						n->react();
+					}
+					delete n;
+					reacted.fetch_add(1);
+					continue;
+				}
+				if(head.load() != tail)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+				std::unique_lock<std::mutex> lock {m};
+				sleeping = true;
+				wake.wait(lock, [this]
+				{
+					return head.load() != tail || stopping;
+				});
+				sleeping = false;
+				if(head.load() == tail && stopping)
+				{
+					return;
+				}
+			}
+		}
+	}
+}
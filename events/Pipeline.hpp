@@ -0,0 +1,100 @@
+#ifndef LB_events_Pipeline_HeaderPlusPlus
+#define LB_events_Pipeline_HeaderPlusPlus
+
+#include "Domain.hpp"
+#include "Event.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace LB
+{
+	namespace events
+	{
+		//Processes events on the calling thread, then moves them to a dispatcher thread which
+		//reacts to them in the order they were queued. Several threads may call() at once, but
+		//unless LB_EVENTS_CONCURRENT is defined their processors must not be shared. Each event
+		//reacts in the EventDomain it was called in, which must outlive its reacting.
+		struct Pipeline final
+		{
+			Pipeline();
+			Pipeline(Pipeline const &) = delete;
+			Pipeline &operator=(Pipeline const &) = delete;
+			Pipeline(Pipeline &&) = delete;
+			Pipeline &operator=(Pipeline &&) = delete;
+			//Reacts to every event still queued before returning
+			~Pipeline() noexcept;
+
+			template<typename EventT>
+			void call(EventT &&e)
+			{
+				using Event_t = typename std::decay<EventT>::type;
+				static_assert(std::is_base_of<Event, Event_t>::value, "EventT must derive from Event");
+				e.process();
+				if(e.reactable())
+				{
+					auto const n = new Queued<Event_t>{std::forward<EventT>(e)};
+					n->domain = EventDomain::current();
+					push(n);
+				}
+			}
+
+			//Blocks until every event queued so far has been reacted to
+			void flush() noexcept;
+
+		private:
+			struct Node
+			{
+				std::atomic<Node *> next {nullptr};
+				EventDomain *domain = nullptr; //where the event was called
+				virtual ~Node() noexcept = default;
+				virtual void react() const noexcept
+				{
+				}
+			};
+			template<typename EventT>
+			struct Queued final
+			: Node
+			{
+				EventT e;
+				Queued(EventT &&e)
+				: e(std::move(e))
+				{
+				}
+				Queued(EventT const &e)
+				: e(e)
+				{
+				}
+				virtual void react() const noexcept override
+				{
+					e.react();
+				}
+			};
+
+			//Intrusive multi-producer single-consumer queue
+			Node stub;
+			std::atomic<Node *> head {&stub};
+			Node *tail = &stub; //dispatcher only
+			std::atomic<std::uint64_t> pushed {0};
+			std::atomic<std::uint64_t> reacted {0};
+
+			std::atomic<bool> sleeping {false};
+			std::atomic<bool> stopping {false};
+			std::mutex m;
+			std::condition_variable wake;
+			std::thread dispatcher;
+
+			void push(Node *n) noexcept;
+			auto pop() noexcept
+			-> Node *;
+			void run() noexcept;
+		};
+	}
+}
+
+#endif
@@ -19,6 +19,12 @@ namespace LB
 			{
 				return inst;
 			}
+			//Lets listeners listen to just one instance
+			virtual auto key() const noexcept
+			-> ListenerKey override
+			{
+				return ListenerKey{std::addressof(inst)};
+			}
 
 		private:
 			T &inst;
@@ -40,6 +46,12 @@ namespace LB
 			{
 				return inst;
 			}
+			//Lets listeners listen to just one instance
+			virtual auto key() const noexcept
+			-> ListenerKey override
+			{
+				return ListenerKey{std::addressof(inst)};
+			}
 
 		private:
 			T &inst;
@@ -0,0 +1,153 @@
+#include "Tracing.hpp"
+
+#ifdef LB_EVENTS_TRACING
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace LB
+{
+	namespace events
+	{
+		namespace
+		{
+			//When tracing was first turned on, to convert ticks to time
+			struct Origin final
+			{
+				std::uint64_t ticks;
+				std::chrono::steady_clock::time_point time;
+			};
+			auto origin() noexcept
+			-> Origin &
+			{
+				static Origin o {};
+				return o;
+			}
+
+			struct Record final
+			{
+				std::uint64_t ticks;
+				void const *id;
+				char const *name;
+				std::uint8_t kind;
+			};
+
+			//Copies the records of b which were completely written and have not been overwritten
+			auto read(impl::Trace::Buffer const &b)
+			-> std::vector<Record>
+			{
+				using Buffer = impl::Trace::Buffer;
+				std::vector<Record> records;
+				auto const head = b.head.load(std::memory_order_acquire);
+				auto i = head > Buffer::CAPACITY? head - Buffer::CAPACITY : 0;
+				if(i < b.start)
+				{
+					i = b.start;
+				}
+				records.reserve(static_cast<std::size_t>(head - i));
+				for(; i < head; ++i)
+				{
+					auto const &r = b.records[i & (Buffer::CAPACITY - 1)];
+					auto const before = r.seq.load(std::memory_order_acquire);
+					Record const copy {r.ticks.load(std::memory_order_relaxed), r.id.load(std::memory_order_relaxed), r.name.load(std::memory_order_relaxed), r.kind.load(std::memory_order_relaxed)};
+					std::atomic_thread_fence(std::memory_order_acquire);
+					if(before == i + 1 && r.seq.load(std::memory_order_relaxed) == before)
+					{
+						records.push_back(copy);
+					}
+				}
+				return records;
+			}
+
+			auto label(Record const &r)
+			-> std::string
+			{
+				using Span = impl::Span;
+				switch(r.kind & ~Span::END)
+				{
+					case Span::CALL: return "call";
+					case Span::PROCESS: return std::string{r.name? r.name : "?"} + " process";
+					case Span::REACT: return std::string{r.name? r.name : "?"} + " react";
+					case Span::PROCESSOR: return "processor";
+					case Span::REACTOR: return "reactor";
+				}
+				return "?";
+			}
+			void escape(std::ostream &out, std::string const &s)
+			{
+				for(auto const c : s)
+				{
+					if(c == '"' || c == '\\')
+					{
+						out << '\\';
+					}
+					out << c;
+				}
+			}
+		}
+
+		void tracing(bool on) noexcept
+		{
+			std::lock_guard<std::mutex> const lock {impl::Trace::mutex()};
+			if(on && origin().ticks == 0)
+			{
+				origin() = {impl::ticks(), std::chrono::steady_clock::now()};
+			}
+			impl::Trace::enabled().store(on);
+		}
+		bool tracing() noexcept
+		{
+			return impl::Trace::enabled().load();
+		}
+
+		void write_trace(std::ostream &out)
+		{
+			std::lock_guard<std::mutex> const lock {impl::Trace::mutex()};
+			auto const start = origin();
+			auto const now_ticks = impl::ticks();
+			auto const now = std::chrono::steady_clock::now();
+			auto const ns = std::chrono::duration<double, std::nano>(now - start.time).count();
+			auto const ns_per_tick = now_ticks > start.ticks? ns/double(now_ticks - start.ticks) : 1.0;
+
+			out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+			bool first = true;
+			char buffer[64];
+			for(auto const &b : impl::Trace::buffers())
+			{
+				//Spans whose beginning has already been overwritten are left out
+				std::size_t depth = 0;
+				for(auto const &r : read(*b))
+				{
+					bool const end = (r.kind & impl::Span::END) != 0;
+					if(end && depth == 0)
+					{
+						continue;
+					}
+					if(end)
+					{
+						--depth;
+					}
+					else
+					{
+						++depth;
+					}
+					auto const us = double(r.ticks - start.ticks)*ns_per_tick/1000.0;
+					out << (first? "\n" : ",\n");
+					first = false;
+					std::snprintf(buffer, sizeof(buffer), "%.3f", us);
+					out << "{\"ph\": \"" << (end? 'E' : 'B') << "\", \"ts\": " << buffer << ", \"pid\": 1, \"tid\": " << b->thread;
+					if(!end)
+					{
+						std::snprintf(buffer, sizeof(buffer), "%p", r.id);
+						out << ", \"cat\": \"events\", \"name\": \"";
+						escape(out, label(r));
+						out << "\", \"args\": {\"id\": \"" << buffer << "\"}";
+					}
+					out << "}";
+				}
+			}
+			out << "\n]}\n";
+		}
+	}
+}
+#endif
@@ -0,0 +1,26 @@
+#ifndef LB_events_Tracing_HeaderPlusPlus
+#define LB_events_Tracing_HeaderPlusPlus
+
+#include "Event.hpp"
+
+#include <ostream>
+
+#ifdef LB_EVENTS_TRACING
+namespace LB
+{
+	namespace events
+	{
+		//Starts or stops recording spans for call(), for the process and react phases of each
+		//class in the hierarchy and for each listener. Every thread keeps only its most recent
+		//records, in a ring buffer of its own.
+		void tracing(bool on) noexcept;
+		bool tracing() noexcept;
+
+		//Writes the records still held as Chrome trace event JSON, which chrome://tracing and
+		//Perfetto open directly. Other threads may keep recording meanwhile.
+		void write_trace(std::ostream &out);
+	}
+}
+#endif
+
+#endif
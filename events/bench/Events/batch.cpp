@@ -0,0 +1,60 @@
+#include "../bench.hpp"
+#include "Event.hpp"
+
+#include <memory>
+#include <vector>
+
+template<typename... Args>
+using EventImplementor = LB::events::Implementor<Args...>;
+template<typename... Args>
+using EventProcessor = LB::events::Processor<Args...>;
+template<typename... Args>
+using EventReactor = LB::events::Reactor<Args...>;
+using Event = LB::events::Event;
+
+struct BenchEvent
+: EventImplementor<BenchEvent, Event>
+{
+	std::size_t x = 0;
+};
+LB_EVENTS_EVENT(BenchEvent);
+
+struct BenchListener
+: private EventProcessor<BenchEvent>
+, private EventReactor<BenchEvent>
+{
+private:
+	virtual void process(BenchEvent &e) const noexcept override
+	{
+		++e.x;
+	}
+	virtual void react(BenchEvent const &e) noexcept override
+	{
+		bench::sink() += e.x;
+	}
+};
+
+//Looped call() against batch call() over 256 events, per event
+int main()
+{
+	for(std::size_t listeners : {1, 10, 100, 1000})
+	{
+		std::vector<std::unique_ptr<BenchListener>> ls;
+		for(std::size_t i = 0; i < listeners; ++i)
+		{
+			ls.emplace_back(new BenchListener);
+		}
+		std::vector<BenchEvent> es(256);
+		bench::measure("batch", "looped", listeners, es.size(), [&]
+		{
+			for(auto &e : es)
+			{
+				e.call();
+			}
+		});
+		bench::measure("batch", "batch", listeners, es.size(), [&]
+		{
+			LB::events::call(es.begin(), es.end());
+		});
+	}
+}
@@ -0,0 +1,64 @@
+#include "../bench.hpp"
+#include "Deferred.hpp"
+
+#include <memory>
+#include <vector>
+
+template<typename... Args>
+using EventImplementor = LB::events::Implementor<Args...>;
+template<typename... Args>
+using EventReactor = LB::events::Reactor<Args...>;
+using Event = LB::events::Event;
+
+struct BenchEvent
+: EventImplementor<BenchEvent, Event>
+{
+	std::size_t x;
+	BenchEvent(std::size_t x) noexcept
+	: x{x}
+	{
+	}
+};
+LB_EVENTS_EVENT(BenchEvent);
+
+struct BenchReactor
+: EventReactor<BenchEvent>
+{
+private:
+	virtual void react(BenchEvent const &e) noexcept override
+	{
+		bench::sink() += e.x;
+	}
+};
+
+//Deferring n events and then calling them, per event
+int main()
+{
+	BenchReactor r;
+	for(std::size_t n : {1, 100, 10000})
+	{
+		std::vector<std::unique_ptr<Event>> heap;
+		heap.reserve(n);
+		bench::measure("deferred", "heap", n, n, [&]
+		{
+			for(std::size_t i = 0; i < n; ++i)
+			{
+				heap.emplace_back(new BenchEvent{i});
+			}
+			for(auto &e : heap)
+			{
+				e->call();
+			}
+			heap.clear();
+		});
+		LB::events::DeferredEvents deferred {1 << 20};
+		bench::measure("deferred", "ring", n, n, [&]
+		{
+			for(std::size_t i = 0; i < n; ++i)
+			{
+				deferred.defer(BenchEvent{i});
+			}
+			deferred.call();
+		});
+	}
+}
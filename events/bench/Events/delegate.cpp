@@ -0,0 +1,116 @@
+#include "../bench.hpp"
+#include "Event.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+template<typename... Args>
+using EventImplementor = LB::events::Implementor<Args...>;
+template<typename... Args>
+using EventReactor = LB::events::Reactor<Args...>;
+template<typename... Args>
+using DelegateReactor = LB::events::DelegateReactor<Args...>;
+using Event = LB::events::Event;
+
+struct VirtualEvent
+: EventImplementor<VirtualEvent, Event>
+{
+	std::size_t x = 1;
+};
+LB_EVENTS_EVENT(VirtualEvent);
+struct DelegateEvent
+: EventImplementor<DelegateEvent, Event>
+{
+	std::size_t x = 1;
+};
+LB_EVENTS_EVENT(DelegateEvent);
+
+struct Counter final
+: EventReactor<VirtualEvent>
+{
+	std::size_t n = 0;
+
+	Counter() noexcept
+	: EventReactor<VirtualEvent>(LB::events::ListenLater{})
+	{
+	}
+	using EventReactor<VirtualEvent>::listen;
+
+private:
+	virtual void react(VirtualEvent const &e) noexcept override
+	{
+		n += e.x;
+	}
+};
+void count(void *n, DelegateEvent const &e) noexcept
+{
+	*static_cast<std::size_t *>(n) += e.x;
+}
+
+//Bytes currently allocated, tracked with a header in front of every allocation
+std::size_t live = 0;
+void *operator new(std::size_t n)
+{
+	if(auto const p = static_cast<std::max_align_t *>(std::malloc(n + sizeof(std::max_align_t))))
+	{
+		*reinterpret_cast<std::size_t *>(p) = n;
+		live += n;
+		return p + 1;
+	}
+	throw std::bad_alloc{};
+}
+void operator delete(void *p) noexcept
+{
+	if(p)
+	{
+		auto const q = static_cast<std::max_align_t *>(p) - 1;
+		live -= *reinterpret_cast<std::size_t *>(q);
+		std::free(q);
+	}
+}
+void operator delete(void *p, std::size_t) noexcept
+{
+	operator delete(p);
+}
+
+//Reports the size of one listener object and the heap the Registrar needs for it, as
+//{"benchmark": "delegate", "case": "...", "n": N, "object": bytes, "heap": bytes}
+template<typename ListenerT, typename F>
+auto footprint(char const *name, std::size_t n, F &&make)
+-> std::vector<std::unique_ptr<ListenerT>>
+{
+	std::vector<std::unique_ptr<ListenerT>> listeners;
+	listeners.reserve(n);
+	for(std::size_t i = 0; i < n; ++i)
+	{
+		listeners.emplace_back(make());
+	}
+	//Listened to only now, so that the heap used by the listeners themselves is not counted
+	auto const before = live;
+	for(auto const &l : listeners)
+	{
+		l->listen();
+	}
+	std::printf("{\"benchmark\": \"delegate\", \"case\": \"%s\", \"n\": %zu, \"object\": %zu, \"heap\": %.1f}\n", name, n, sizeof(ListenerT), double(live - before)/n);
+	std::fflush(stdout);
+	return listeners;
+}
+
+//Many small reactors, as virtual reactors or as delegates
+int main()
+{
+	constexpr std::size_t N = 10000;
+	std::size_t total = 0;
+	{
+		auto const rs = footprint<Counter>("virtual", N, []{ return new Counter{}; });
+		bench::measure("delegate", "virtual", N, N, []{ VirtualEvent{}.call(); });
+	}
+	{
+		auto const rs = footprint<DelegateReactor<DelegateEvent>>("delegate", N, [&]{ return new DelegateReactor<DelegateEvent>{&count, &total, LB::events::ListenLater{}}; });
+		bench::measure("delegate", "delegate", N, N, []{ DelegateEvent{}.call(); });
+	}
+	bench::sink() += total;
+}
@@ -0,0 +1,58 @@
+#include "../bench.hpp"
+#include "Event.hpp"
+
+#include <memory>
+#include <vector>
+
+template<typename... Args>
+using EventImplementor = LB::events::Implementor<Args...>;
+template<typename... Args>
+using EventProcessor = LB::events::Processor<Args...>;
+template<typename... Args>
+using EventReactor = LB::events::Reactor<Args...>;
+using Event = LB::events::Event;
+
+struct BenchEvent
+: EventImplementor<BenchEvent, Event>
+{
+	std::size_t x = 0;
+};
+LB_EVENTS_EVENT(BenchEvent);
+
+struct BenchListener
+: private EventProcessor<BenchEvent>
+, private EventReactor<BenchEvent>
+{
+	BenchListener(LB::events::ListenerPriority priority) noexcept
+	: EventProcessor<BenchEvent>(priority)
+	, EventReactor<BenchEvent>(priority)
+	{
+	}
+
+private:
+	virtual void process(BenchEvent &e) const noexcept override
+	{
+		++e.x;
+	}
+	virtual void react(BenchEvent const &e) noexcept override
+	{
+		bench::sink() += e.x;
+	}
+};
+
+//Cost of each phase against the number of listeners on one event type
+int main()
+{
+	for(std::size_t listeners : {0, 1, 10, 100, 1000, 10000})
+	{
+		std::vector<std::unique_ptr<BenchListener>> ls;
+		for(std::size_t i = 0; i < listeners; ++i)
+		{
+			ls.emplace_back(new BenchListener(static_cast<LB::events::ListenerPriority::Priority_t>(i % 16)));
+		}
+		BenchEvent e;
+		bench::measure("dispatch", "call", listeners, 1, []{ BenchEvent{}.call(); });
+		bench::measure("dispatch", "process", listeners, 1, [&]{ e.process(); });
+		bench::measure("dispatch", "react", listeners, 1, [&]{ e.react(); });
+	}
+}
@@ -0,0 +1,68 @@
+#include "../bench.hpp"
+#include "Cancellable.hpp"
+#include "Exclusive.hpp"
+
+#include <memory>
+#include <vector>
+
+template<typename... Args>
+using EventImplementor = LB::events::Implementor<Args...>;
+template<typename... Args>
+using EventReactor = LB::events::Reactor<Args...>;
+using Event = LB::events::Event;
+using CancellableEvent = LB::events::Cancellable;
+using ExclusiveEvent = LB::events::Exclusive;
+
+struct PlainEvent : EventImplementor<PlainEvent, Event> {}; LB_EVENTS_EVENT(PlainEvent);
+struct CancelEvent : EventImplementor<CancelEvent, CancellableEvent> {}; LB_EVENTS_EVENT(CancelEvent);
+struct ClaimEvent : EventImplementor<ClaimEvent, ExclusiveEvent> {}; LB_EVENTS_EVENT(ClaimEvent);
+
+template<typename EventT>
+struct BenchReactor
+: EventReactor<EventT>
+{
+private:
+	virtual void react(EventT const &) noexcept override
+	{
+		++bench::sink();
+	}
+};
+
+template<typename EventT>
+auto listeners(std::size_t n)
+-> std::vector<std::unique_ptr<BenchReactor<EventT>>>
+{
+	std::vector<std::unique_ptr<BenchReactor<EventT>>> ls;
+	for(std::size_t i = 0; i < n; ++i)
+	{
+		ls.emplace_back(new BenchReactor<EventT>);
+	}
+	return ls;
+}
+
+//React phase of unfiltered, cancelled and claimed events
+int main()
+{
+	for(std::size_t n : {1, 10, 100, 1000})
+	{
+		{
+			auto ls = listeners<PlainEvent>(n);
+			PlainEvent e;
+			bench::measure("filter", "plain", n, 1, [&]{ e.react(); });
+		}
+		{
+			auto ls = listeners<CancelEvent>(n);
+			CancelEvent e;
+			bench::measure("filter", "not-cancelled", n, 1, [&]{ e.react(); });
+			e.cancelled(true);
+			bench::measure("filter", "cancelled", n, 1, [&]{ e.react(); });
+		}
+		{
+			auto ls = listeners<ClaimEvent>(n);
+			ClaimEvent e;
+			bench::measure("filter", "unclaimed", n, 1, [&]{ e.react(); });
+			e.claim(ls.back().get());
+			bench::measure("filter", "claimed", n, 1, [&]{ e.react(); });
+		}
+	}
+}
@@ -0,0 +1,76 @@
+#include "../bench.hpp"
+#include "Event.hpp"
+
+template<typename... Args>
+using EventImplementor = LB::events::Implementor<Args...>;
+template<typename... Args>
+using EventProcessor = LB::events::Processor<Args...>;
+template<typename... Args>
+using EventReactor = LB::events::Reactor<Args...>;
+using Event = LB::events::Event;
+
+//A straight chain, D0 through D7
+struct D0 : EventImplementor<D0, Event> {}; LB_EVENTS_EVENT(D0);
+struct D1 : EventImplementor<D1, D0> {}; LB_EVENTS_EVENT(D1);
+struct D2 : EventImplementor<D2, D1> {}; LB_EVENTS_EVENT(D2);
+struct D3 : EventImplementor<D3, D2> {}; LB_EVENTS_EVENT(D3);
+struct D4 : EventImplementor<D4, D3> {}; LB_EVENTS_EVENT(D4);
+struct D5 : EventImplementor<D5, D4> {}; LB_EVENTS_EVENT(D5);
+struct D6 : EventImplementor<D6, D5> {}; LB_EVENTS_EVENT(D6);
+struct D7 : EventImplementor<D7, D6> {}; LB_EVENTS_EVENT(D7);
+
+//The diamond from test/Events/order.cpp
+struct E0 : EventImplementor<E0, Event> {}; LB_EVENTS_EVENT(E0);
+struct E1 : EventImplementor<E1, E0> {}; LB_EVENTS_EVENT(E1);
+struct E2 : EventImplementor<E2, E0> {}; LB_EVENTS_EVENT(E2);
+struct E3 : EventImplementor<E3, E0> {}; LB_EVENTS_EVENT(E3);
+struct E4 : EventImplementor<E4, E0> {}; LB_EVENTS_EVENT(E4);
+struct E5 : EventImplementor<E5, E1, E2> {}; LB_EVENTS_EVENT(E5);
+struct E6 : EventImplementor<E6, E3, E4> {}; LB_EVENTS_EVENT(E6);
+struct E7 : EventImplementor<E7, E5, E6> {}; LB_EVENTS_EVENT(E7);
+
+template<typename EventT>
+struct BenchListener
+: private EventProcessor<EventT>
+, private EventReactor<EventT>
+{
+private:
+	virtual void process(EventT &) const noexcept override
+	{
+	}
+	virtual void react(EventT const &) noexcept override
+	{
+		++bench::sink();
+	}
+};
+
+template<typename EventT>
+void measure(char const *benchmark, std::size_t levels)
+{
+	EventT e;
+	bench::measure(benchmark, "call", levels, 1, []{ EventT{}.call(); });
+	bench::measure(benchmark, "process", levels, 1, [&]{ e.process(); });
+	bench::measure(benchmark, "react", levels, 1, [&]{ e.react(); });
+}
+
+//Cost of walking the hierarchy, with nobody listening, with a listener on the most derived
+//class only, and with one listener on every level; n is the number of levels
+int main()
+{
+	measure<D7>("hierarchy-empty", 8);
+	{
+		BenchListener<D7> only;
+		measure<D7>("hierarchy-sparse", 8);
+	}
+
+	BenchListener<D0> d0; BenchListener<D1> d1; BenchListener<D2> d2; BenchListener<D3> d3;
+	BenchListener<D4> d4; BenchListener<D5> d5; BenchListener<D6> d6; BenchListener<D7> d7;
+	measure<D0>("hierarchy-chain", 1);
+	measure<D1>("hierarchy-chain", 2);
+	measure<D3>("hierarchy-chain", 4);
+	measure<D7>("hierarchy-chain", 8);
+
+	BenchListener<E0> e0; BenchListener<E1> e1; BenchListener<E2> e2; BenchListener<E3> e3;
+	BenchListener<E4> e4; BenchListener<E5> e5; BenchListener<E6> e6; BenchListener<E7> e7;
+	measure<E7>("hierarchy-diamond", 8);
+}
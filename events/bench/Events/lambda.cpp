@@ -0,0 +1,80 @@
+#include "../bench.hpp"
+#include "Event.hpp"
+
+#include <memory>
+#include <vector>
+
+template<typename... Args>
+using EventImplementor = LB::events::Implementor<Args...>;
+template<typename... Args>
+using EventProcessor = LB::events::Processor<Args...>;
+template<typename... Args>
+using EventReactor = LB::events::Reactor<Args...>;
+template<typename... Args>
+using LambdaEventProcessor = LB::events::LambdaProcessor<Args...>;
+template<typename... Args>
+using LambdaEventReactor = LB::events::LambdaReactor<Args...>;
+using Event = LB::events::Event;
+
+struct BenchEvent
+: EventImplementor<BenchEvent, Event>
+{
+	std::size_t x = 0;
+};
+LB_EVENTS_EVENT(BenchEvent);
+
+struct BenchListener
+: private EventProcessor<BenchEvent>
+, private EventReactor<BenchEvent>
+{
+private:
+	virtual void process(BenchEvent &e) const noexcept override
+	{
+		++e.x;
+	}
+	virtual void react(BenchEvent const &e) noexcept override
+	{
+		bench::sink() += e.x;
+	}
+};
+
+void measure(char const *name, std::size_t listeners)
+{
+	BenchEvent e;
+	bench::measure("lambda", name, listeners, 1, [&]{ e.process(); });
+}
+
+//Hand-written listeners against std::function and inline lambda listeners, process phase only
+int main()
+{
+	for(std::size_t listeners : {1, 10, 100, 1000})
+	{
+		{
+			std::vector<std::unique_ptr<BenchListener>> ls;
+			for(std::size_t i = 0; i < listeners; ++i)
+			{
+				ls.emplace_back(new BenchListener);
+			}
+			measure("virtual", listeners);
+		}
+		{
+			std::vector<LambdaEventProcessor<BenchEvent>> ls;
+			ls.reserve(listeners);
+			for(std::size_t i = 0; i < listeners; ++i)
+			{
+				ls.emplace_back([](BenchEvent &e){ ++e.x; });
+			}
+			measure("function", listeners);
+		}
+		{
+			auto l = [](BenchEvent &e){ ++e.x; };
+			std::vector<LambdaEventProcessor<BenchEvent, decltype(l)>> ls;
+			ls.reserve(listeners);
+			for(std::size_t i = 0; i < listeners; ++i)
+			{
+				ls.emplace_back(l);
+			}
+			measure("inline", listeners);
+		}
+	}
+}
@@ -0,0 +1,70 @@
+#include "../bench.hpp"
+#include "Event.hpp"
+
+#include <memory>
+#include <vector>
+
+template<typename... Args>
+using EventImplementor = LB::events::Implementor<Args...>;
+template<typename... Args>
+using EventReactor = LB::events::Reactor<Args...>;
+using Event = LB::events::Event;
+using Sampling = LB::events::Sampling;
+
+struct HotEvent : EventImplementor<HotEvent, Event> {}; LB_EVENTS_EVENT(HotEvent);
+
+//Keeps one event in every hundred itself, as observability reactors do without Sampling
+struct Filtering final
+: EventReactor<HotEvent>
+{
+	std::size_t seen = 0;
+
+private:
+	virtual void react(HotEvent const &) noexcept override
+	{
+		if(seen++ % 100 == 0)
+		{
+			++bench::sink();
+		}
+	}
+};
+//Leaves the choice to the Registrar
+struct Sampled final
+: EventReactor<HotEvent>
+{
+	Sampled(Sampling s) noexcept
+	: EventReactor<HotEvent>(LB::events::ListenLater{})
+	{
+		listen(s);
+	}
+
+private:
+	virtual void react(HotEvent const &) noexcept override
+	{
+		++bench::sink();
+	}
+};
+
+template<typename F>
+void measure(char const *name, std::size_t n, F make)
+{
+	std::vector<std::unique_ptr<EventReactor<HotEvent>>> ls;
+	for(std::size_t i = 0; i < n; ++i)
+	{
+		ls.emplace_back(make());
+	}
+	HotEvent e;
+	bench::measure("sampling", name, n, 1, [&]{ e.react(); });
+}
+
+//React phase of a hot event with n observability reactors which each want about 1% of it
+int main()
+{
+	for(std::size_t n : {1, 10})
+	{
+		measure("in-reactor", n, []{ return new Filtering{}; });
+		measure("every", n, []{ return new Sampled{Sampling::every(100)}; });
+		measure("probability", n, []{ return new Sampled{Sampling::probability(0.01)}; });
+		measure("rate", n, []{ return new Sampled{Sampling::rate(1000)}; });
+	}
+}
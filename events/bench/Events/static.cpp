@@ -0,0 +1,64 @@
+#include "../bench.hpp"
+#include "Event.hpp"
+
+template<typename... Args>
+using EventImplementor = LB::events::Implementor<Args...>;
+template<typename... Args>
+using EventProcessor = LB::events::Processor<Args...>;
+template<typename... Args>
+using EventReactor = LB::events::Reactor<Args...>;
+using Event = LB::events::Event;
+
+struct DynamicEvent
+: EventImplementor<DynamicEvent, Event>
+{
+	std::size_t x = 0;
+};
+LB_EVENTS_EVENT(DynamicEvent);
+struct StaticEvent
+: EventImplementor<StaticEvent, Event>
+{
+	std::size_t x = 0;
+};
+
+void increment(StaticEvent &e) noexcept
+{
+	++e.x;
+}
+void consume(StaticEvent const &e) noexcept
+{
+	bench::sink() += e.x;
+}
+template<>
+struct LB::events::StaticListeners<StaticEvent>
+: LB::events::StaticList
+<
+	LB::events::StaticProcessor<StaticEvent, &increment>,
+	LB::events::StaticReactor<StaticEvent, &consume>
+>
+{
+};
+LB_EVENTS_EVENT(StaticEvent);
+
+struct DynamicListener
+: private EventProcessor<DynamicEvent>
+, private EventReactor<DynamicEvent>
+{
+private:
+	virtual void process(DynamicEvent &e) const noexcept override
+	{
+		++e.x;
+	}
+	virtual void react(DynamicEvent const &e) noexcept override
+	{
+		bench::sink() += e.x;
+	}
+};
+
+//One processor and one reactor, listening at run time or listed at compile time
+int main()
+{
+	DynamicListener const l;
+	bench::measure("static", "dynamic", 1, 1, []{ DynamicEvent{}.call(); });
+	bench::measure("static", "static", 1, 1, []{ StaticEvent{}.call(); });
+}
@@ -0,0 +1,35 @@
+#include "../bench.hpp"
+#include "Tracing.hpp"
+
+template<typename... Args>
+using EventImplementor = LB::events::Implementor<Args...>;
+template<typename... Args>
+using EventReactor = LB::events::Reactor<Args...>;
+using Event = LB::events::Event;
+
+struct TracedEvent
+: EventImplementor<TracedEvent, Event>
+{
+	std::size_t x = 1;
+};
+LB_EVENTS_EVENT(TracedEvent);
+
+struct Counter final
+: EventReactor<TracedEvent>
+{
+private:
+	virtual void react(TracedEvent const &e) noexcept override
+	{
+		bench::sink() += e.x;
+	}
+};
+
+//One reactor; a traced call() records 6 spans, 12 records
+int main()
+{
+	Counter const c;
+	bench::measure("tracing", "off", 1, 1, []{ TracedEvent{}.call(); });
+	LB::events::tracing(true);
+	bench::measure("tracing", "on", 1, 1, []{ TracedEvent{}.call(); });
+	LB::events::tracing(false);
+}
@@ -0,0 +1,58 @@
+#ifndef LB_events_bench_HeaderPlusPlus
+#define LB_events_bench_HeaderPlusPlus
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+//Benchmarks print one JSON object per line so results can be diffed between releases:
+//{"benchmark": "...", "case": "...", "n": N, "ns": nanoseconds per op, "mops": millions of ops per second}
+namespace bench
+{
+	using clock = std::chrono::steady_clock;
+
+	//Keeps the optimizer from discarding work
+	inline std::size_t &sink() noexcept
+	{
+		static std::size_t s = 0;
+		return s;
+	}
+
+	//Times f, which performs ops operations per run, and reports the median of several samples
+	template<typename F>
+	void measure(char const *benchmark, char const *name, std::size_t n, std::size_t ops, F &&f)
+	{
+		std::size_t runs = 1;
+		for(;;)
+		{
+			auto const start = clock::now();
+			for(std::size_t i = 0; i < runs; ++i)
+			{
+				f();
+			}
+			if(clock::now() - start >= std::chrono::milliseconds(10))
+			{
+				break;
+			}
+			runs *= 2;
+		}
+		std::vector<double> samples;
+		for(int s = 0; s < 5; ++s)
+		{
+			auto const start = clock::now();
+			for(std::size_t i = 0; i < runs; ++i)
+			{
+				f();
+			}
+			samples.push_back(std::chrono::duration<double, std::nano>(clock::now() - start).count()/(runs*ops));
+		}
+		std::nth_element(samples.begin(), samples.begin() + 2, samples.end());
+		auto const ns = samples[2];
+		std::printf("{\"benchmark\": \"%s\", \"case\": \"%s\", \"n\": %zu, \"ns\": %.2f, \"mops\": %.3f}\n", benchmark, name, n, ns, 1e3/ns);
+		std::fflush(stdout);
+	}
+}
+
+#endif
@@ -3,6 +3,7 @@ message(STATUS "Fixup file: @_export@")
 file(READ "@_export@" _config)
 file(WRITE "@_export@"
 	"find_package(LB/cloning REQUIRED)\n"
-	"find_package(LB/tuples REQUIRED)\n\n"
+	"find_package(LB/tuples REQUIRED)\n"
+	"find_package(Threads REQUIRED)\n\n"
 	"${_config}"
 )
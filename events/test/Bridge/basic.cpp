@@ -0,0 +1,195 @@
+#undef NDEBUG
+
+#include "Bridge.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+template<typename... Args>
+using EventImplementor = LB::events::Implementor<Args...>;
+template<typename... Args>
+using LambdaEventReactor = LB::events::LambdaReactor<Args...>;
+using Event = LB::events::Event;
+
+struct Price
+: EventImplementor<Price, Event>
+{
+	static constexpr LB::events::BridgeType_t BRIDGE_TYPE = 1;
+	struct Payload final
+	{
+		std::uint32_t id;
+		double value;
+	};
+
+	Payload p;
+	Price(std::uint32_t id, double value) noexcept
+	: p{id, value}
+	{
+	}
+
+	auto payload() const noexcept
+	-> Payload
+	{
+		return p;
+	}
+	static auto load(Payload const &p) noexcept
+	-> Price
+	{
+		return {p.id, p.value};
+	}
+};
+LB_EVENTS_EVENT(Price);
+struct Local
+: EventImplementor<Local, Event>
+{
+	static constexpr LB::events::BridgeType_t BRIDGE_TYPE = 2;
+	auto payload() const noexcept
+	-> int
+	{
+		return 0;
+	}
+	static auto load(int) noexcept
+	-> Local
+	{
+		return {};
+	}
+};
+LB_EVENTS_EVENT(Local);
+struct Blob
+: EventImplementor<Blob, Event>
+{
+	static constexpr LB::events::BridgeType_t BRIDGE_TYPE = 3;
+	struct Payload final
+	{
+		char bytes[256];
+	};
+	auto payload() const noexcept
+	-> Payload
+	{
+		return {};
+	}
+	static auto load(Payload const &) noexcept
+	-> Blob
+	{
+		return {};
+	}
+};
+LB_EVENTS_EVENT(Blob);
+
+std::string const NAME = "/lb-events-test-bridge-" + std::to_string(::getpid());
+constexpr std::size_t CAPACITY = 32;
+
+//Hands a byte from one process to the other
+void send(int fd)
+{
+	char const c = 0;
+	assert(::write(fd, &c, 1) == 1);
+}
+void receive(int fd)
+{
+	char c;
+	assert(::read(fd, &c, 1) == 1);
+}
+
+//The subscribing process: returns its exit status
+int subscriber(int to_parent, int from_parent)
+{
+	LB::events::BridgeSubscriber bridge {NAME};
+	bridge.subscribe<Price>();
+	std::uint32_t last = 0;
+	double sum = 0;
+	LambdaEventReactor<Price> r {[&](Price const &e)
+	{
+		if(e.p.id != last + 1)
+		{
+			std::_Exit(2);
+		}
+		last = e.p.id;
+		sum += e.p.value;
+	}};
+	send(to_parent);
+
+	//Every entry arrives in order, and types not subscribed to are skipped
+	auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+	while(last < 10 && std::chrono::steady_clock::now() < deadline)
+	{
+		bridge.poll();
+	}
+	if(last != 10 || sum != 55*0.5 || bridge.lost() != 0)
+	{
+		return 3;
+	}
+	send(to_parent);
+
+	//Entries overwritten before being read are counted, and reading resumes after them
+	receive(from_parent);
+	last = 100 - CAPACITY + 1;
+	auto const n = bridge.poll();
+	if(n != CAPACITY - 1 || last != 100 || bridge.lost() != 100 - 10 - (CAPACITY - 1))
+	{
+		return 4;
+	}
+	return bridge.poll() == 0? 0 : 5;
+}
+
+int main()
+{
+	int up[2], down[2];
+	assert(::pipe(up) == 0 && ::pipe(down) == 0);
+	LB::events::BridgePublisher bridge {NAME, CAPACITY, sizeof(Price::Payload)};
+
+	auto const child = ::fork();
+	assert(child >= 0);
+	if(child == 0)
+	{
+		::close(up[0]);
+		::close(down[1]);
+		std::_Exit(subscriber(up[1], down[0]));
+	}
+	::close(up[1]);
+	::close(down[0]);
+	//Only in this process, or the subscriber would publish what it receives
+	bridge.publish<Price>();
+	bridge.publish<Local>();
+	receive(up[0]);
+
+	//Published after every local reactor
+	std::uint32_t seen = 0;
+	LambdaEventReactor<Price> local {[&](Price const &){ assert(bridge.written() == seen*2); ++seen; }};
+	for(std::uint32_t i = 1; i <= 10; ++i)
+	{
+		Price{i, i*0.5}.call();
+		Local{}.call();
+	}
+	assert(bridge.written() == 20);
+	receive(up[0]);
+
+	//Overrun the subscriber
+	for(std::uint32_t i = 11; i <= 100; ++i)
+	{
+		bridge.write(Price{i, 0});
+	}
+	send(down[1]);
+
+	int status = 0;
+	assert(::waitpid(child, &status, 0) == child);
+	assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+	//Too large payloads are refused up front
+	LB::events::BridgePublisher small {NAME + "-small", 4, 8};
+	try
+	{
+		small.publish<Blob>();
+		assert(false);
+	}
+	catch(std::length_error const &)
+	{
+	}
+}
@@ -0,0 +1,117 @@
+#undef NDEBUG
+
+#include "Budgeted.hpp"
+#include "Cancellable.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+template<typename... Args>
+using EventImplementor = LB::events::Implementor<Args...>;
+template<typename... Args>
+using LambdaEventReactor = LB::events::LambdaReactor<Args...>;
+using Event = LB::events::Event;
+using Cancellable = LB::events::Cancellable;
+using Dispatcher = LB::events::BudgetedDispatcher;
+
+struct Parent
+: EventImplementor<Parent, Cancellable>
+{
+};
+LB_EVENTS_EVENT(Parent);
+struct Child
+: EventImplementor<Child, Parent>
+{
+};
+LB_EVENTS_EVENT(Child);
+
+int main()
+{
+	std::string log;
+	auto reactor = [&](char const *name, int priority, bool slow = false)
+	{
+		return std::unique_ptr<LambdaEventReactor<Parent>>{new LambdaEventReactor<Parent>{[&log, name, slow](Parent const &)
+		{
+			log += name;
+			if(slow)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds{2});
+			}
+		}, priority}};
+	};
+	auto a = reactor("a", -10);
+	auto b = reactor("b", 0, true);
+	auto c = reactor("c", 0);
+	LambdaEventReactor<Child> d {[&](Child const &){ log += "d"; }, -5};
+	LambdaEventReactor<Child> e {[&](Child const &){ log += "e"; }, 0};
+	LambdaEventReactor<Child> f {[&](Child const &){ log += "f"; }, 10};
+
+	Child{}.call();
+	assert(log == "abcdef");
+	log.clear();
+
+	int overruns = 0;
+	Dispatcher::Clock_t::duration late {};
+	Dispatcher dispatcher {-1, [&](Dispatcher::Clock_t::duration overrun)
+	{
+		++overruns;
+		late = overrun;
+	}};
+
+	//Reactors of priority up to the threshold react at once, in every class of the hierarchy
+	dispatcher.call(Child{});
+	assert(log == "ad" && dispatcher.size() == 1);
+
+	//A slice which starts no reactor is not an overrun
+	assert(!dispatcher.run(Dispatcher::Clock_t::now()));
+	assert(log == "ad" && overruns == 0);
+
+	//A reactor which starts in time finishes, then the overrun is reported
+	assert(!dispatcher.run_for(std::chrono::milliseconds{1}));
+	assert(log == "adb");
+	assert(overruns == 1 && late >= std::chrono::milliseconds{1});
+
+	//Reactors which already reacted may come and go without reacting twice or holding up the rest
+	b.reset();
+	auto g = reactor("g", 0);
+	assert(dispatcher.run_for(std::chrono::hours{1}));
+	assert(log == "adbcgef" && dispatcher.empty());
+	assert(overruns == 1);
+	log.clear();
+
+	//Cancelled events are never held on to
+	struct Canceller final
+	: LB::events::Processor<Parent>
+	{
+		virtual void process(Parent &p) const noexcept override
+		{
+			p.cancelled(true);
+		}
+	};
+	{
+		Canceller const cancel;
+		dispatcher.call(Child{});
+	}
+	assert(log.empty() && dispatcher.empty());
+
+	//Events called by reactors react inline at once, then wait behind the ones already held
+	bool again = true;
+	LambdaEventReactor<Child> h {[&](Child const &)
+	{
+		if(again)
+		{
+			again = false;
+			dispatcher.call(Child{});
+		}
+	}, 5};
+	dispatcher.call(Child{});
+	dispatcher.call(Child{});
+	assert(log == "adad" && dispatcher.size() == 2);
+	dispatcher.flush();
+	assert(log == "adad" "cgeadf" "cgef" "cgef");
+	assert(dispatcher.empty());
+	assert(overruns == 1);
+}
@@ -0,0 +1,71 @@
+#undef NDEBUG
+
+#include "Cancellable.hpp"
+
+#include <cassert>
+
+template<typename... Args>
+using EventImplementor = LB::events::Implementor<Args...>;
+template<typename... Args>
+using LambdaEventProcessor = LB::events::LambdaProcessor<Args...>;
+template<typename... Args>
+using LambdaEventReactor = LB::events::LambdaReactor<Args...>;
+using CancellableEvent = LB::events::Cancellable;
+
+int checks = 0;
+
+struct TestEvent
+: EventImplementor<TestEvent, CancellableEvent>
+{
+	int x;
+	TestEvent(int x) noexcept
+	: x(x)
+	{
+	}
+
+	virtual bool should_react(LB::events::ReactorBase const &r) const noexcept override
+	{
+		++checks;
+		return CancellableEvent::should_react(r);
+	}
+};
+LB_EVENTS_EVENT(TestEvent);
+
+int main() noexcept
+{
+	int processed = 0;
+	int reacted = 0;
+	LambdaEventProcessor<TestEvent> canceller {[](TestEvent &e)
+	{
+		if(e.x < 0)
+		{
+			e.cancelled(true);
+		}
+		if(e.x < -10)
+		{
+			e.cancel_final();
+		}
+	}, LB::events::ListenerPriority::FIRST};
+	LambdaEventProcessor<TestEvent> overrider {[&](TestEvent &e)
+	{
+		++processed;
+		e.cancelled(false);
+	}};
+	LambdaEventReactor<CancellableEvent> r1 {[&](CancellableEvent const &){ ++reacted; }};
+	LambdaEventReactor<TestEvent> r2 {[&](TestEvent const &){ ++reacted; }};
+
+	//A later processor may still take back an ordinary cancellation
+	TestEvent{-5}.call();
+	assert(processed == 1);
+	assert(reacted == 2);
+
+	//A final cancellation stops the remaining processors, and no reactor is even considered
+	checks = 0;
+	TestEvent e {-50};
+	e.call();
+	assert(e.cancelled());
+	assert(e.processing_stopped());
+	assert(processed == 1);
+	assert(reacted == 2);
+	assert(checks == 0);
+}
@@ -0,0 +1,94 @@
+#undef NDEBUG
+
+#include "Coalescing.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <string>
+#include <vector>
+
+template<typename... Args>
+using EventImplementor = LB::events::Implementor<Args...>;
+template<typename... Args>
+using LambdaEventReactor = LB::events::LambdaReactor<Args...>;
+using Event = LB::events::Event;
+using Key = LB::events::ListenerKey;
+
+//Without a key or coalesce(), the latest one wins
+struct Resize
+: EventImplementor<Resize, Event>
+{
+	int w, h;
+	Resize(int w, int h) noexcept
+	: w{w}
+	, h{h}
+	{
+	}
+};
+LB_EVENTS_EVENT(Resize);
+
+//Keyed by entity, and the moves add up
+struct Move
+: EventImplementor<Move, Event>
+{
+	int entity, dx;
+	Move(int entity, int dx) noexcept
+	: entity{entity}
+	, dx{dx}
+	{
+	}
+	virtual auto key() const noexcept
+	-> Key override
+	{
+		return Key{entity};
+	}
+	void coalesce(Move &&later) noexcept
+	{
+		dx += later.dx;
+	}
+};
+LB_EVENTS_EVENT(Move);
+
+int main()
+{
+	std::vector<std::string> seen;
+	LambdaEventReactor<Resize> resized {[&](Resize const &e){ seen.push_back("resize " + std::to_string(e.w) + "x" + std::to_string(e.h)); }};
+	LambdaEventReactor<Move> moved {[&](Move const &e){ seen.push_back("move " + std::to_string(e.entity) + " " + std::to_string(e.dx)); }};
+
+	LB::events::CoalescingQueue queue;
+	queue.post(Move{1, 5});
+	for(int i = 1; i <= 100; ++i)
+	{
+		queue.post(Resize{i, i*2});
+		queue.post(Move{2, 1});
+	}
+	queue.post(Move{1, -2});
+	assert(queue.size() == 3);
+	assert(queue.coalesced() == 199);
+	assert(seen.empty());
+	assert(queue.flush() == 3);
+	assert((seen == std::vector<std::string>{"move 1 3", "resize 100x200", "move 2 100"}));
+	assert(queue.size() == 0);
+
+	//Events posted while flushing wait for the next flush
+	seen.clear();
+	LambdaEventReactor<Resize> again {[&](Resize const &e)
+	{
+		if(e.w == 1)
+		{
+			queue.post(Resize{2, 2});
+		}
+	}};
+	queue.post(Resize{1, 1});
+	assert(queue.flush() == 1);
+	assert(queue.size() == 1);
+	assert(queue.flush() == 1);
+	assert((seen == std::vector<std::string>{"resize 1x1", "resize 2x2"}));
+
+	//With a time bound of zero, every post flushes straight away
+	seen.clear();
+	LB::events::CoalescingQueue eager {std::chrono::seconds{0}};
+	eager.post(Move{3, 1});
+	assert(seen.size() == 1);
+	assert(eager.size() == 0);
+}
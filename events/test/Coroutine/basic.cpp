@@ -0,0 +1,184 @@
+#undef NDEBUG
+
+#include "Coroutine.hpp"
+
+#include <cassert>
+#include <cstdlib>
+#include <exception>
+#include <new>
+
+#ifndef LB_EVENTS_COROUTINES
+#error "Coroutines should be available in C++20"
+#endif
+
+template<typename... Args>
+using EventImplementor = LB::events::Implementor<Args...>;
+using Event = LB::events::Event;
+using Key = LB::events::ListenerKey;
+using LB::events::next;
+
+std::size_t allocations = 0;
+void *operator new(std::size_t n)
+{
+	++allocations;
+	if(void *p = std::malloc(n))
+	{
+		return p;
+	}
+	throw std::bad_alloc{};
+}
+void operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+void operator delete(void *p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+struct Ping
+: EventImplementor<Ping, Event>
+{
+	int n;
+	Ping(int n) noexcept
+	: n{n}
+	{
+	}
+};
+LB_EVENTS_EVENT(Ping);
+
+struct Reply
+: EventImplementor<Reply, Event>
+{
+	int request, value;
+	Reply(int request, int value) noexcept
+	: request{request}
+	, value{value}
+	{
+	}
+	virtual auto key() const noexcept
+	-> Key override
+	{
+		return Key{request};
+	}
+};
+LB_EVENTS_EVENT(Reply);
+
+//Starts right away and stays suspended at the end until destroyed
+struct Task final
+{
+	struct promise_type final
+	{
+		auto get_return_object() noexcept
+		-> Task
+		{
+			return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+		}
+		auto initial_suspend() noexcept
+		-> std::suspend_never
+		{
+			return {};
+		}
+		auto final_suspend() noexcept
+		-> std::suspend_always
+		{
+			return {};
+		}
+		void return_void() noexcept
+		{
+		}
+		void unhandled_exception() noexcept
+		{
+			std::terminate();
+		}
+	};
+	std::coroutine_handle<promise_type> h;
+	explicit Task(std::coroutine_handle<promise_type> h) noexcept
+	: h{h}
+	{
+	}
+	Task(Task const &) = delete;
+	Task &operator=(Task const &) = delete;
+	~Task() noexcept
+	{
+		h.destroy();
+	}
+	bool done() const noexcept
+	{
+		return h.done();
+	}
+};
+
+int main()
+{
+	//Waiting for a matching event
+	int seen = 0;
+	auto waiter = [&]() -> Task
+	{
+		auto const &p = co_await next<Ping>([](Ping const &p){ return p.n == 3; });
+		seen = p.n;
+	};
+	{
+		Task const t = waiter();
+		assert(!t.done());
+		Ping{1}.call();
+		Ping{2}.call();
+		assert(!t.done() && seen == 0);
+		Ping{3}.call();
+		assert(t.done() && seen == 3);
+		Ping{3}.call();
+	}
+
+	//Awaiting over and over allocates nothing beyond the coroutine frame
+	int sum = 0;
+	auto summer = [&](int count) -> Task
+	{
+		for(int i = 0; i < count; ++i)
+		{
+			sum += (co_await next<Ping>()).n;
+		}
+	};
+	{
+		//Listening again from inside a react phase needs room set aside once
+		Task const warm = summer(2);
+		Ping{0}.call();
+		Ping{0}.call();
+		assert(warm.done());
+	}
+	{
+		Task const t = summer(100);
+		auto const before = allocations;
+		for(int i = 1; i <= 100; ++i)
+		{
+			Ping{i}.call();
+		}
+		assert(t.done());
+#ifndef LB_EVENTS_CONCURRENT
+		assert(allocations == before);
+#endif
+		assert(sum == 5050);
+	}
+
+	//Destroying a suspended coroutine stops it waiting
+	{
+		Task const t = summer(1);
+	}
+	Ping{1}.call();
+	assert(sum == 5050);
+
+	//Waiting for the reply to one request among many
+	int replies[2] {};
+	auto request = [&](int id) -> Task
+	{
+		replies[id] = (co_await next<Reply>(Key{id})).value;
+	};
+	{
+		Task const a = request(0);
+		Task const b = request(1);
+		Reply{1, 10}.call();
+		assert(!a.done() && b.done());
+		Reply{0, 20}.call();
+		assert(a.done());
+		assert(replies[0] == 20 && replies[1] == 10);
+	}
+}
@@ -0,0 +1,139 @@
+#undef NDEBUG
+
+#include "Deferred.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+template<typename... Args>
+using EventImplementor = LB::events::Implementor<Args...>;
+template<typename... Args>
+using LambdaEventReactor = LB::events::LambdaReactor<Args...>;
+using Event = LB::events::Event;
+
+std::size_t allocations = 0;
+void *operator new(std::size_t n)
+{
+	++allocations;
+	if(void *p = std::malloc(n))
+	{
+		return p;
+	}
+	throw std::bad_alloc{};
+}
+void operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+void operator delete(void *p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+int alive = 0;
+
+struct Small
+: EventImplementor<Small, Event>
+{
+	int n;
+	Small(int n) noexcept
+	: n{n}
+	{
+		++alive;
+	}
+	Small(Small const &from) noexcept
+	: n{from.n}
+	{
+		++alive;
+	}
+	~Small() noexcept
+	{
+		--alive;
+	}
+};
+LB_EVENTS_EVENT(Small);
+
+struct Large
+: EventImplementor<Large, Event>
+{
+	int n;
+	std::array<char, 4096> payload {};
+	Large(int n) noexcept
+	: n{n}
+	{
+	}
+};
+LB_EVENTS_EVENT(Large);
+
+int main()
+{
+	std::vector<int> order;
+	order.reserve(100000);
+	LambdaEventReactor<Small> rs {[&](Small const &e){ order.push_back(e.n); }};
+	LambdaEventReactor<Large> rl {[&](Large const &e){ order.push_back(-e.n); }};
+	LB::events::DeferredEvents deferred {1024};
+
+	//Calling once first, so that every registrar in the hierarchy exists
+	//(LB_EVENTS_CONCURRENT and LB_EVENTS_METRICS allocate when constructing one)
+	Small{0}.call();
+	order.clear();
+
+	//Filling and draining the buffer over and over, wrapping around, never allocates
+	auto const before = allocations;
+	for(int round = 0; round < 100; ++round)
+	{
+		for(int i = 0; i < 5; ++i)
+		{
+			deferred.defer(Small{i});
+		}
+		assert(deferred.call() == 5);
+	}
+	assert(allocations == before);
+	assert(order.size() == 500);
+	assert(alive == 0);
+
+	//Large events and whatever does not fit are allocated, but the order is kept
+	order.clear();
+	for(int i = 0; i < 100; ++i)
+	{
+		if(i % 10 == 0)
+		{
+			deferred.defer(Large{i});
+		}
+		else
+		{
+			deferred.defer(Small{i});
+		}
+	}
+	assert(allocations > before);
+	assert(deferred.call() == 100);
+	assert(deferred.empty());
+	for(int i = 0; i < 100; ++i)
+	{
+		assert(order[i] == (i % 10 == 0? -i : i));
+	}
+
+	//Events deferred while calling are called too
+	order.clear();
+	LambdaEventReactor<Small> chain {[&](Small const &e)
+	{
+		if(e.n < 50)
+		{
+			deferred.defer(Small{e.n + 1});
+		}
+	}};
+	deferred.defer(Small{0});
+	assert(deferred.call() == 51);
+	assert(order.size() == 51 && order.back() == 50);
+
+	//Events never called are still destroyed
+	{
+		LB::events::DeferredEvents lost;
+		lost.defer(Small{1});
+		lost.defer(Large{2});
+	}
+	assert(alive == 0);
+}
@@ -0,0 +1,125 @@
+#undef NDEBUG
+
+#include "Domain.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <thread>
+
+template<typename... Args>
+using EventImplementor = LB::events::Implementor<Args...>;
+template<typename... Args>
+using LambdaEventReactor = LB::events::LambdaReactor<Args...>;
+using Event = LB::events::Event;
+using Domain = LB::events::EventDomain;
+
+struct Parent
+: EventImplementor<Parent, Event>
+{
+};
+LB_EVENTS_EVENT(Parent);
+struct Child
+: EventImplementor<Child, Parent>
+{
+	int shard;
+	Child(int shard) noexcept
+	: shard{shard}
+	{
+	}
+};
+LB_EVENTS_EVENT(Child);
+
+int main() noexcept
+{
+	int global = 0;
+	LambdaEventReactor<Parent> r0 {[&](Parent const &){ ++global; }};
+
+	//Listeners and calls within a Scope only see that domain
+	Domain a;
+	{
+		Domain::Scope const scope {a};
+		assert(Domain::current() == &a);
+		int local = 0;
+		LambdaEventReactor<Parent> r {[&](Parent const &){ ++local; }};
+		Child{0}.call();
+		assert(local == 1 && global == 0);
+		{
+			Domain::Scope const outside {nullptr};
+			assert(Domain::current() == nullptr);
+			Child{0}.call();
+			assert(local == 1 && global == 1);
+		}
+		Child{0}.call();
+		assert(local == 2 && global == 1);
+	}
+	assert(Domain::current() == nullptr);
+	Child{0}.call();
+	assert(global == 2);
+
+	//A listener stops listening to its own domain wherever it is destroyed
+	int moved = 0;
+	LambdaEventReactor<Child> *r1;
+	{
+		Domain::Scope const scope {a};
+		r1 = new LambdaEventReactor<Child>{[&](Child const &){ ++moved; }};
+		Child{0}.call();
+	}
+	assert(moved == 1 && Child::listening(*r1));
+	delete r1;
+	{
+		Domain::Scope const scope {a};
+		Child{0}.call();
+	}
+	assert(moved == 1);
+
+	//One domain per thread, each dispatching to its own listeners and forwarding to the other
+	constexpr int N = 10000;
+	Domain shards[2];
+	std::atomic<int> ready {0};
+	int seen[2][2] {};
+	auto shard = [&](int self)
+	{
+		Domain::Scope const scope {shards[self]};
+		LambdaEventReactor<Child> r {[&](Child const &e){ ++seen[self][e.shard]; }};
+		++ready;
+		while(ready.load() < 2)
+		{
+		}
+		for(int i = 0; i < N; ++i)
+		{
+			Child{self}.call();
+			shards[1 - self].forward(Child{self});
+			shards[self].drain();
+		}
+		++ready;
+		while(ready.load() < 4)
+		{
+			shards[self].drain();
+		}
+		shards[self].drain();
+	};
+	std::thread t0 {shard, 0};
+	std::thread t1 {shard, 1};
+	t0.join();
+	t1.join();
+	assert(seen[0][0] == N && seen[0][1] == N);
+	assert(seen[1][1] == N && seen[1][0] == N);
+	assert(global == 2);
+
+	//Forwarded events wait for drain(), which calls them within the domain
+	int drained = 0;
+	{
+		Domain::Scope const scope {a};
+		LambdaEventReactor<Child> r {[&](Child const &){ ++drained; }};
+		{
+			Domain::Scope const outside {nullptr};
+			a.forward(Child{0});
+			a.forward(Child{0});
+			assert(drained == 0);
+			assert(a.drain() == 2);
+		}
+		assert(drained == 2);
+		assert(a.drain() == 0);
+	}
+	assert(global == 2);
+}
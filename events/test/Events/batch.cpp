@@ -0,0 +1,95 @@
+#undef NDEBUG
+
+#include "Cancellable.hpp"
+#include "Exclusive.hpp"
+
+#include <array>
+#include <cassert>
+#include <string>
+#include <utility>
+#include <vector>
+
+template<typename... Args>
+using EI = LB::events::Implementor<Args...>;
+template<typename... Args>
+using ER = LB::events::Reactor<Args...>;
+template<typename... Args>
+using LER = LB::events::LambdaReactor<Args...>;
+template<typename... Args>
+using DR = LB::events::DelegateReactor<Args...>;
+using C = LB::events::Cancellable;
+using X = LB::events::Exclusive;
+
+struct E0 : EI<E0, C> { int n; E0(int n) noexcept : n(n) {} }; LB_EVENTS_EVENT(E0);
+struct E1 : EI<E1, E0> { E1(int n) noexcept : E0(n) {} }; LB_EVENTS_EVENT(E1);
+
+std::vector<std::pair<int, int>> po {};
+std::vector<std::pair<int, int>> ro {};
+std::string trace;
+
+struct Gated : EI<Gated, C> {};
+struct Job : EI<Job, X> {};
+void gated_static(Gated const &) { trace += "s"; }
+template<>
+struct LB::events::StaticListeners<Gated>
+: LB::events::StaticList<LB::events::StaticReactor<Gated, &gated_static>>
+{
+};
+LB_EVENTS_EVENT(Gated);
+LB_EVENTS_EVENT(Job);
+
+int main() noexcept
+{
+	auto p0 = LB::events::lambda_processor<E0>([](E0 &e){ po.emplace_back(0, e.n); });
+	auto r0 = LB::events::lambda_reactor<E0>([](E0 const &e){ ro.emplace_back(0, e.n); });
+	auto p1 = LB::events::lambda_processor<E1>([](E1 &e){ po.emplace_back(1, e.n); e.cancelled(e.n == 1); });
+	auto r1 = LB::events::lambda_reactor<E1>([](E1 const &e){ ro.emplace_back(1, e.n); });
+	auto r2 = LB::events::lambda_reactor<E1>([](E1 const &e){ ro.emplace_back(2, e.n); }, 1);
+
+	std::vector<E1> es;
+	for(int i = 0; i < 3; ++i)
+	{
+		es.emplace_back(i);
+	}
+	LB::events::call(es.begin(), es.end());
+	assert((po == std::vector<std::pair<int, int>>{{0, 0}, {0, 1}, {0, 2}, {1, 0}, {1, 1}, {1, 2}}));
+	assert((ro == std::vector<std::pair<int, int>>{{0, 0}, {0, 2}, {1, 0}, {1, 2}, {2, 0}, {2, 2}}));
+
+	po.clear();
+	ro.clear();
+	E0 const plain[] {E0{4}, E0{5}};
+	LB::events::react(std::begin(plain), std::end(plain));
+	assert(po.empty());
+	assert((ro == std::vector<std::pair<int, int>>{{0, 4}, {0, 5}}));
+
+	//Cancelled events are left out of the batch for every kind of reactor
+	{
+		LER<Gated> r {[](Gated const &){ trace += "r"; }};
+		DR<Gated> d {[](void *, Gated const &){ trace += "d"; }, nullptr};
+		std::array<Gated, 4> gs {};
+		for(auto &g : gs)
+		{
+			g.cancelled(true);
+		}
+		LB::events::react(gs.begin(), gs.end());
+		assert(trace.empty());
+
+		gs[2].cancelled(false);
+		LB::events::react(gs.begin(), gs.end());
+		assert(trace == "sdr");
+		trace.clear();
+	}
+
+	//Claimed events go straight to their reactor, and unclaimed ones nowhere
+	{
+		LER<Job> a {[](Job const &){ trace += "a"; }};
+		LER<Job> b {[](Job const &){ trace += "b"; }};
+		DR<Job> d {[](void *, Job const &){ trace += "d"; }, nullptr};
+		std::array<Job, 4> js {};
+		js[0].claim(static_cast<ER<Job> &>(b));
+		js[2].claim(static_cast<ER<Job> &>(a));
+		LB::events::react(js.begin(), js.end());
+		assert(trace == "ba");
+		trace.clear();
+	}
+}
@@ -0,0 +1,218 @@
+#undef NDEBUG
+
+#include "Event.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <thread>
+#include <vector>
+
+template<typename... Args>
+using EI = LB::events::Implementor<Args...>;
+template<typename... Args>
+using ER = LB::events::Reactor<Args...>;
+template<typename... Args>
+using LER = LB::events::LambdaReactor<Args...>;
+using E = LB::events::Event;
+
+struct TestEvent : EI<TestEvent, E> {}; LB_EVENTS_EVENT(TestEvent);
+struct OtherEvent : EI<OtherEvent, E> {}; LB_EVENTS_EVENT(OtherEvent);
+struct KeyedEvent : EI<KeyedEvent, E>
+{
+	std::size_t k;
+	KeyedEvent(std::size_t k) noexcept
+	: k{k}
+	{
+	}
+	virtual auto key() const noexcept
+	-> LB::events::ListenerKey override
+	{
+		return LB::events::ListenerKey{k};
+	}
+};
+LB_EVENTS_EVENT(KeyedEvent);
+
+std::atomic<std::size_t> calls {0};
+std::atomic<std::size_t> churned {0};
+
+struct ChurnReactor
+: ER<TestEvent>
+{
+	std::atomic<bool> alive {true};
+	bool once;
+
+	ChurnReactor(bool once) noexcept
+	: ER<TestEvent>(LB::events::ListenLater{})
+	, once(once)
+	{
+		//Listeners used from several threads must be fully constructed before they listen
+		listen();
+	}
+	virtual ~ChurnReactor() noexcept
+	{
+		//...and must stop listening before their own state goes away
+		ignore();
+		alive = false;
+	}
+
+private:
+	virtual void react(TestEvent const &e) noexcept override
+	{
+		assert(alive);
+		++churned;
+		if(once)
+		{
+			ignore();
+		}
+	}
+};
+
+struct SlowReactor final
+: ER<TestEvent>
+{
+	std::atomic<bool> alive {true};
+
+	SlowReactor() noexcept
+	: ER<TestEvent>(LB::events::ListenLater{})
+	{
+		listen();
+	}
+	virtual ~SlowReactor() noexcept
+	{
+		ignore();
+		alive = false;
+	}
+
+private:
+	virtual void react(TestEvent const &) noexcept override
+	{
+		assert(alive);
+		std::this_thread::yield();
+		assert(alive);
+	}
+};
+
+struct KeyedReactor final
+: ER<KeyedEvent>
+{
+	std::atomic<bool> alive {true};
+
+	KeyedReactor(std::size_t k) noexcept
+	: ER<KeyedEvent>(LB::events::ListenLater{})
+	{
+		listen(LB::events::ListenerKey{k});
+	}
+	virtual ~KeyedReactor() noexcept
+	{
+		ignore();
+		alive = false;
+	}
+
+private:
+	virtual void react(KeyedEvent const &) noexcept override
+	{
+		assert(alive);
+		++churned;
+	}
+};
+
+int main() noexcept
+{
+	std::size_t const THREADS = 4;
+	std::size_t const CALLS = 20000;
+	LER<TestEvent> counter {[](TestEvent const &e){ ++calls; }};
+	std::atomic<bool> done {false};
+	std::thread churn {[&]
+	{
+		while(!done)
+		{
+			std::vector<std::unique_ptr<ChurnReactor>> rs;
+			for(std::size_t i = 0; i < 16; ++i)
+			{
+				rs.emplace_back(new ChurnReactor{i % 2 == 0});
+			}
+			std::this_thread::yield();
+		}
+	}};
+	std::vector<std::thread> callers;
+	for(std::size_t t = 0; t < THREADS; ++t)
+	{
+		callers.emplace_back([&]
+		{
+			for(std::size_t i = 0; i < CALLS; ++i)
+			{
+				TestEvent{}.call();
+			}
+		});
+	}
+	for(auto &t : callers)
+	{
+		t.join();
+	}
+	done = true;
+	churn.join();
+	assert(calls == THREADS*CALLS);
+
+	//Reacting to one event type does not excuse ignoring a reactor of another from waiting for
+	//the threads which are calling it
+	{
+		LER<OtherEvent> destroyer {[](OtherEvent const &)
+		{
+			std::unique_ptr<SlowReactor> const r {new SlowReactor};
+			std::this_thread::yield();
+		}};
+		done = false;
+		std::thread caller {[&]
+		{
+			while(!done)
+			{
+				TestEvent{}.call();
+			}
+		}};
+		for(std::size_t i = 0; i < CALLS/10; ++i)
+		{
+			OtherEvent{}.call();
+		}
+		done = true;
+		caller.join();
+	}
+
+	//Keys come and go while other threads call them
+	{
+		std::size_t const KEYS = 4;
+		done = false;
+		std::thread keys {[&]
+		{
+			while(!done)
+			{
+				std::vector<std::unique_ptr<KeyedReactor>> rs;
+				for(std::size_t i = 0; i < KEYS; ++i)
+				{
+					rs.emplace_back(new KeyedReactor{i});
+				}
+				std::this_thread::yield();
+			}
+		}};
+		calls = 0;
+		LER<KeyedEvent> counter {[](KeyedEvent const &){ ++calls; }};
+		callers.clear();
+		for(std::size_t t = 0; t < THREADS; ++t)
+		{
+			callers.emplace_back([&, t]
+			{
+				for(std::size_t i = 0; i < CALLS; ++i)
+				{
+					KeyedEvent{(t + i) % KEYS}.call();
+				}
+			});
+		}
+		for(auto &t : callers)
+		{
+			t.join();
+		}
+		done = true;
+		keys.join();
+		assert(calls == THREADS*CALLS);
+	}
+}
@@ -0,0 +1,171 @@
+#undef NDEBUG
+
+#include "Budgeted.hpp"
+#include "Event.hpp"
+#include "Exclusive.hpp"
+
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <string>
+#include <thread>
+
+template<typename... Args>
+using EI = LB::events::Implementor<Args...>;
+template<typename... Args>
+using DP = LB::events::DelegateProcessor<Args...>;
+template<typename... Args>
+using DR = LB::events::DelegateReactor<Args...>;
+template<typename... Args>
+using LEP = LB::events::LambdaProcessor<Args...>;
+template<typename... Args>
+using LER = LB::events::LambdaReactor<Args...>;
+template<typename... Args>
+using ER = LB::events::Reactor<Args...>;
+using E = LB::events::Event;
+using LP = LB::events::ListenerPriority;
+
+std::string trace;
+
+struct Parent : EI<Parent, E>
+{
+	bool stop = false;
+};
+struct Child : EI<Child, Parent>
+{
+	int n = 0;
+};
+
+void parent_static(Parent &) { trace += "S"; }
+
+template<>
+struct LB::events::StaticListeners<Parent>
+: LB::events::StaticList
+<
+	LB::events::StaticProcessor<Parent, &parent_static>
+>
+{
+};
+LB_EVENTS_EVENT(Parent);
+LB_EVENTS_EVENT(Child);
+
+struct Job : EI<Job, LB::events::Exclusive>
+{
+	bool direct = false;
+};
+LB_EVENTS_EVENT(Job);
+
+//Appends its name to the trace, and may stop processing or ignore another delegate
+struct Tracer final
+{
+	char const *name;
+	DR<Parent> *victim = nullptr;
+
+	static void process(void *context, Parent &p)
+	{
+		auto &self = *static_cast<Tracer *>(context);
+		trace += self.name;
+		if(p.stop)
+		{
+			p.stop_processing();
+		}
+	}
+	static void react(void *context, Parent const &)
+	{
+		auto &self = *static_cast<Tracer *>(context);
+		trace += self.name;
+		if(self.victim)
+		{
+			self.victim->ignore();
+		}
+	}
+};
+
+int main() noexcept
+{
+	Tracer a {"a"}, b {"b"}, c {"c"}, x {"x"}, y {"y"};
+
+	//At the same priority static listeners go first, then delegates, then virtual listeners
+	LEP<Parent> v {[](Parent &){ trace += "v"; }};
+	DP<Parent> d0 {&Tracer::process, &a};
+	DP<Parent> d5 {&Tracer::process, &b, 5};
+	DP<Parent> dl {&Tracer::process, &c, LB::events::ListenLater{}};
+	assert(!dl.listening());
+	dl.listen(LP::FIRST);
+	assert(dl.listening());
+	Child{}.call();
+	assert(trace == "cSavb");
+	trace.clear();
+
+	//Stopping processing stops delegates too
+	Child stopped {};
+	stopped.stop = true;
+	stopped.call();
+	assert(trace == "c");
+	trace.clear();
+	dl.ignore();
+	assert(!dl.listening());
+
+	//Batches call each delegate with the whole range in turn
+	std::array<Child, 2> batch {};
+	LB::events::call(batch.begin(), batch.end());
+	assert(trace == "SSaavvbb");
+	trace.clear();
+
+	//Delegates ignored during a dispatch do not react in it
+	DR<Parent> victim {&Tracer::react, &y, 1};
+	x.victim = &victim;
+	{
+		DR<Parent> killer {&Tracer::react, &x};
+		Child{}.call();
+		assert(trace == "Savb" "x");
+		assert(!victim.listening());
+		trace.clear();
+	}
+
+	//Budgeted dispatch resumes after delegates which already reacted, even when delegates
+	//start listening in between
+	{
+		DR<Parent> fast {&Tracer::react, &y};
+		LER<Parent> slow {[](Parent const &)
+		{
+			trace += "V";
+			std::this_thread::sleep_for(std::chrono::milliseconds{2});
+		}};
+		LER<Parent> last {[](Parent const &){ trace += "W"; }};
+		LB::events::BudgetedDispatcher dispatcher {-1};
+		dispatcher.call(Child{});
+		trace.clear();
+		assert(!dispatcher.run_for(std::chrono::milliseconds{1}));
+		assert(trace == "yV");
+		DR<Parent> late {&Tracer::react, &a};
+		dispatcher.flush();
+		assert(trace == "yV" "aW");
+		trace.clear();
+	}
+
+	//Delegates do not react to an Exclusive event, whichever way it was claimed
+	{
+		DR<Job> d {[](void *, Job const &){ trace += "d"; }, nullptr};
+		LER<Job> worker {[](Job const &){ trace += "w"; }};
+		LEP<Job> claimer {[&](Job &j)
+		{
+			if(j.direct)
+			{
+				j.claim(static_cast<ER<Job> &>(worker));
+			}
+			else
+			{
+				j.claim(&worker);
+			}
+		}};
+		Job{}.call();
+		Job direct {};
+		direct.direct = true;
+		direct.call();
+		LB::events::BudgetedDispatcher dispatcher {-1};
+		dispatcher.call(Job{});
+		dispatcher.flush();
+		assert(trace == "www");
+	}
+}
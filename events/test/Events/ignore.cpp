@@ -0,0 +1,129 @@
+#undef NDEBUG
+
+#include "Event.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <vector>
+
+template<typename... Args>
+using EI = LB::events::Implementor<Args...>;
+template<typename... Args>
+using ER = LB::events::Reactor<Args...>;
+using E = LB::events::Event;
+using LP = LB::events::ListenerPriority;
+
+struct TestEvent : EI<TestEvent, E> {}; LB_EVENTS_EVENT(TestEvent);
+
+std::vector<int> ro {};
+
+struct TestReactor
+: ER<TestEvent>
+{
+	int n;
+	bool once = false;
+	std::unique_ptr<TestReactor> victim;
+	std::unique_ptr<TestReactor> spawn;
+
+	TestReactor(int n, LP priority = LP{}) noexcept
+	: ER<TestEvent>(priority)
+	, n(n)
+	{
+	}
+
+	using ER<TestEvent>::listen;
+	using ER<TestEvent>::ignore;
+
+private:
+	virtual void react(TestEvent const &e) noexcept override
+	{
+		ro.push_back(n);
+		if(once)
+		{
+			ignore();
+		}
+		victim.reset();
+		if(spawn)
+		{
+			spawn->listen(LP::FIRST);
+		}
+	}
+};
+
+auto fire() noexcept
+-> std::vector<int>
+{
+	ro.clear();
+	TestEvent{}.call();
+	return ro;
+}
+
+int main() noexcept
+{
+	TestReactor r0 {0};
+	TestReactor r1 {1};
+	TestReactor r2 {2};
+	r1.once = true;
+	r0.victim.reset(new TestReactor{3});
+	assert((fire() == std::vector<int>{0, 1, 2}));
+	assert((fire() == std::vector<int>{0, 2}));
+
+	r2.spawn.reset(new TestReactor{4});
+	r2.spawn->ignore();
+	assert((fire() == std::vector<int>{0, 2}));
+	auto const spawned = std::move(r2.spawn);
+	assert((fire() == std::vector<int>{4, 0, 2}));
+	spawned->ignore();
+
+	r1.once = false;
+	r1.listen(-1);
+	r0.listen(1);
+	assert((fire() == std::vector<int>{1, 2, 0}));
+
+	{
+		std::vector<std::unique_ptr<TestReactor>> many;
+		for(int i = 0; i < 10000; ++i)
+		{
+			many.emplace_back(new TestReactor{10 + i, i % 3});
+		}
+		for(std::size_t i = 0; i < many.size(); i += 2)
+		{
+			many[i].reset();
+		}
+		auto const o = fire();
+		assert(o.size() == 3 + 5000);
+		for(std::size_t i = 2; i < o.size(); ++i)
+		{
+			assert(o[i - 1] < 10 || o[i] < 10 || (o[i - 1] - 10)%3 < (o[i] - 10)%3 || ((o[i - 1] - 10)%3 == (o[i] - 10)%3 && o[i - 1] < o[i]));
+		}
+	}
+	assert((fire() == std::vector<int>{1, 2, 0}));
+
+	//Changing priority moves a listener behind those which already have its new priority
+	{
+		std::vector<std::unique_ptr<TestReactor>> many;
+		std::vector<int> by[4];
+		for(int i = 0; i < 100; ++i)
+		{
+			many.emplace_back(new TestReactor{10 + i, i % 4});
+			by[i % 4].push_back(10 + i);
+		}
+		for(int i = 0; i < 100; i += 3)
+		{
+			auto &from = by[i % 4];
+			from.erase(std::find(from.begin(), from.end(), 10 + i));
+			many[static_cast<std::size_t>(i)]->listen((i + 1) % 4);
+			by[(i + 1) % 4].push_back(10 + i);
+		}
+		std::vector<int> expected {1, 2};
+		expected.insert(expected.end(), by[0].begin(), by[0].end());
+		expected.push_back(0);
+		for(auto const &b : {by[1], by[2], by[3]})
+		{
+			expected.insert(expected.end(), b.begin(), b.end());
+		}
+		assert(fire() == expected);
+	}
+	assert((fire() == std::vector<int>{1, 2, 0}));
+}
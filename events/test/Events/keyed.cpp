@@ -0,0 +1,178 @@
+#undef NDEBUG
+
+#include "Event.hpp"
+#include "RAII.hpp"
+
+#include <cassert>
+#include <vector>
+
+template<typename... Args>
+using EI = LB::events::Implementor<Args...>;
+template<typename... Args>
+using EP = LB::events::Processor<Args...>;
+template<typename... Args>
+using ER = LB::events::Reactor<Args...>;
+template<typename... Args>
+using LEP = LB::events::LambdaProcessor<Args...>;
+using E = LB::events::Event;
+using Key = LB::events::ListenerKey;
+using LP = LB::events::ListenerPriority;
+
+struct Topic : EI<Topic, E>
+{
+	int topic;
+	Topic(int t) noexcept
+	: topic{t}
+	{
+	}
+	virtual auto key() const noexcept
+	-> Key override
+	{
+		return Key{topic};
+	}
+};
+LB_EVENTS_EVENT(Topic);
+
+std::vector<int> order;
+
+struct Subscriber
+: EP<Topic>
+, ER<Topic>
+{
+	int id;
+	Subscriber(int id, Key key, LP priority) noexcept
+	: EP<Topic>(LB::events::ListenLater{})
+	, ER<Topic>(LB::events::ListenLater{})
+	, id{id}
+	{
+		EP<Topic>::listen(key, priority);
+		ER<Topic>::listen(key, priority);
+	}
+	void resubscribe(Key key) noexcept
+	{
+		EP<Topic>::listen(key);
+		ER<Topic>::listen(key);
+	}
+	void unsubscribe() noexcept
+	{
+		EP<Topic>::ignore();
+		ER<Topic>::ignore();
+	}
+
+private:
+	virtual void process(Topic &) const noexcept override
+	{
+		order.push_back(id);
+	}
+	virtual void react(Topic const &) noexcept override
+	{
+		order.push_back(-id);
+	}
+};
+
+struct Entity;
+LB_EVENTS_EVENT(LB::events::Construct<Entity>);
+struct Entity
+{
+	Entity() noexcept
+	{
+		announce();
+	}
+	void announce() noexcept
+	{
+		LB::events::Construct<Entity>{*this}.call();
+	}
+};
+
+int main() noexcept
+{
+	//Wildcard and keyed listeners are merged in priority order
+	Subscriber all1 {1, Key{}, 0};
+	Subscriber all3 {3, Key{}, 20};
+	Subscriber a2 {2, Key{7}, 10};
+	Subscriber a4 {4, Key{7}, 20};
+	Subscriber b5 {5, Key{8}, 0};
+	Topic{7}.call();
+	assert((order == std::vector<int>{1, 2, 3, 4, -1, -2, -3, -4}));
+
+	order.clear();
+	Topic{8}.call();
+	assert((order == std::vector<int>{1, 5, 3, -1, -5, -3}));
+
+	order.clear();
+	Topic{9}.call();
+	assert((order == std::vector<int>{1, 3, -1, -3}));
+
+	//Listening again with another key moves the listener
+	order.clear();
+	a2.resubscribe(Key{8});
+	Topic{7}.call();
+	assert((order == std::vector<int>{1, 3, 4, -1, -3, -4}));
+
+	order.clear();
+	b5.unsubscribe();
+	a2.resubscribe(Key{});
+	Topic{8}.call();
+	assert((order == std::vector<int>{1, 2, 3, -1, -2, -3}));
+	assert(!Topic::listening(static_cast<EP<Topic> const &>(b5)));
+
+	//Batches still reach the keyed listeners of each event
+	order.clear();
+	std::vector<Topic> batch {Topic{7}, Topic{9}};
+	LB::events::call(batch.begin(), batch.end());
+	assert((order == std::vector<int>{1, 2, 3, 4, 1, 2, 3, -1, -2, -3, -4, -1, -2, -3}));
+
+	//Construct and Destruct are keyed by their instance
+	int constructed = 0;
+	Entity a;
+	struct Watcher
+	: EP<LB::events::Construct<Entity>>
+	{
+		int &n;
+		Watcher(Entity const &e, int &n) noexcept
+		: EP<LB::events::Construct<Entity>>(LB::events::ListenLater{})
+		, n(n)
+		{
+			listen(Key{&e});
+		}
+
+	private:
+		virtual void process(LB::events::Construct<Entity> &) const noexcept override
+		{
+			++n;
+		}
+	} watcher {a, constructed};
+	Entity b;
+	assert(constructed == 0);
+	a.announce();
+	b.announce();
+	assert(constructed == 1);
+
+	//The last listener of a key may stop listening while the key is being called
+	{
+		struct Once
+		: ER<Topic>
+		{
+			int n = 0;
+			Once() noexcept
+			: ER<Topic>(LB::events::ListenLater{})
+			{
+				listen(Key{9});
+			}
+			using ER<Topic>::listen;
+
+		private:
+			virtual void react(Topic const &) noexcept override
+			{
+				++n;
+				ignore();
+			}
+		} once;
+		Topic{9}.call();
+		Topic{9}.call();
+		assert(once.n == 1 && !Topic::listening(once));
+		once.listen(Key{9});
+		Topic{9}.call();
+		assert(once.n == 2);
+	}
+}
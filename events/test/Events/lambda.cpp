@@ -0,0 +1,71 @@
+#undef NDEBUG
+
+#include "Event.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+template<typename... Args>
+using EI = LB::events::Implementor<Args...>;
+using E = LB::events::Event;
+
+struct TestEvent : EI<TestEvent, E>
+{
+	int x = 0;
+};
+LB_EVENTS_EVENT(TestEvent);
+
+std::size_t allocations = 0;
+void *operator new(std::size_t n)
+{
+	++allocations;
+	if(void *p = std::malloc(n))
+	{
+		return p;
+	}
+	throw std::bad_alloc{};
+}
+void operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+void operator delete(void *p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+int main() noexcept
+{
+	std::array<int, 32> big {};
+	big[31] = 3;
+	int sum = 0;
+	auto listen = [&]
+	{
+		auto p = LB::events::lambda_processor<TestEvent>([big](TestEvent &e){ e.x += big[31]; });
+		auto r = LB::events::lambda_reactor<TestEvent>([big, &sum](TestEvent const &e) mutable { sum += e.x + big[0]++; });
+		TestEvent{}.call();
+	};
+	listen();
+	assert(sum == 3);
+
+	//Once the registrar has room, short-lived lambda listeners do not allocate at all
+	//(LB_EVENTS_CONCURRENT publishes a new snapshot of the listeners on every listen())
+	auto const before = allocations;
+	for(int i = 0; i < 100; ++i)
+	{
+		listen();
+	}
+#ifndef LB_EVENTS_CONCURRENT
+	assert(allocations == before);
+#endif
+	assert(sum == 3*101);
+
+	//Lambda_t is still std::function by default
+	LB::events::LambdaReactor<TestEvent> compat {[&](TestEvent const &e){ sum = -1; }};
+	static_assert(std::is_same<decltype(compat)::Lambda_t, std::function<void (TestEvent const &)>>::value, "");
+	TestEvent{}.call();
+	assert(sum == -1);
+}
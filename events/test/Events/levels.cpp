@@ -0,0 +1,141 @@
+#undef NDEBUG
+
+#include "Domain.hpp"
+#include "Event.hpp"
+
+#include <cassert>
+#include <memory>
+#include <string>
+
+template<typename... Args>
+using EI = LB::events::Implementor<Args...>;
+template<typename... Args>
+using LEP = LB::events::LambdaProcessor<Args...>;
+template<typename... Args>
+using LER = LB::events::LambdaReactor<Args...>;
+template<typename... Args>
+using DR = LB::events::DelegateReactor<Args...>;
+template<typename EventT>
+using R = LB::events::Registrar<EventT>;
+using E = LB::events::Event;
+using D = LB::events::EventDomain;
+
+std::string trace;
+
+struct A : EI<A, E>
+{
+};
+LB_EVENTS_EVENT(A);
+struct B : EI<B, A>
+{
+};
+LB_EVENTS_EVENT(B);
+struct C : EI<C, B>
+{
+	LB::events::ListenerKey k;
+	virtual auto key() const noexcept
+	-> LB::events::ListenerKey override
+	{
+		return k;
+	}
+};
+LB_EVENTS_EVENT(C);
+struct Sibling : EI<Sibling, B>
+{
+};
+LB_EVENTS_EVENT(Sibling);
+
+int main() noexcept
+{
+	//Nothing listens anywhere
+	assert(!R<A>::processing() && !R<A>::reacting());
+	C{}.call();
+	Sibling{}.call();
+
+	//Only the levels with listeners are visited, but every one of them is
+	{
+		LER<C> c {[](C const &){ trace += "c"; }};
+		assert(R<C>::reacting() && !R<C>::processing());
+		C{}.call();
+		assert(trace == "c");
+		trace.clear();
+
+		//Both C and Sibling cached B as empty; listening to B is seen by both
+		LER<B> b {[](B const &){ trace += "b"; }};
+		C{}.call();
+		Sibling{}.call();
+		assert(trace == "bcb");
+		trace.clear();
+	}
+	C{}.call();
+	Sibling{}.call();
+	assert(trace.empty());
+
+	//A level which gains listeners during a dispatch is not skipped in it
+	{
+		std::unique_ptr<LEP<C>> late;
+		bool once = true;
+		LEP<A> a {[&](A &)
+		{
+			trace += "a";
+			if(once)
+			{
+				late.reset(new LEP<C>{[](C &){ trace += "C"; }});
+				once = false;
+			}
+		}};
+		C{}.call();
+		assert(trace == "aC");
+		trace.clear();
+		late.reset();
+		C{}.call();
+		assert(trace == "a");
+		trace.clear();
+	}
+
+	//Keyed listeners and delegates count as listeners, and so do batches
+	{
+		LER<C> keyed {[](C const &){ trace += "k"; }};
+		R<C>::listen(keyed, LB::events::ListenerKey{1});
+		C one {};
+		one.k = LB::events::ListenerKey{1};
+		one.call();
+		C{}.call();
+		assert(trace == "k");
+		trace.clear();
+
+		DR<B> d {[](void *, B const &){ trace += "d"; }, nullptr};
+		C batch[2] {};
+		LB::events::call(batch, batch + 2);
+		assert(trace == "dd");
+		trace.clear();
+	}
+	assert(!R<B>::reacting() && !R<C>::reacting());
+
+	//Each domain keeps its own levels, and only the level which changed is looked at again
+	{
+		D d;
+		C{}.call();
+		{
+			D::Scope const scope {d};
+			LER<B> b {[](B const &){ trace += "b"; }};
+			LEP<C> c {[](C &){ trace += "p"; }};
+			C{}.call();
+			Sibling{}.call();
+			assert(trace == "pbb");
+			trace.clear();
+		}
+		C{}.call();
+		Sibling{}.call();
+		assert(trace.empty());
+		LER<A> a {[](A const &){ trace += "a"; }};
+		{
+			D::Scope const scope {d};
+			C{}.call();
+			assert(trace.empty());
+		}
+		C{}.call();
+		assert(trace == "a");
+		trace.clear();
+	}
+}
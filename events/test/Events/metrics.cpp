@@ -0,0 +1,71 @@
+#undef NDEBUG
+
+#include "Event.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+template<typename... Args>
+using EI = LB::events::Implementor<Args...>;
+template<typename... Args>
+using LEP = LB::events::LambdaProcessor<Args...>;
+template<typename... Args>
+using LER = LB::events::LambdaReactor<Args...>;
+using E = LB::events::Event;
+using EM = LB::events::EventMetrics;
+
+struct Base : EI<Base, E> {}; LB_EVENTS_EVENT(Base);
+struct Derived : EI<Derived, Base> {}; LB_EVENTS_EVENT(Derived);
+struct Unused : EI<Unused, E> {}; LB_EVENTS_EVENT(Unused);
+
+auto find(char const *name)
+-> EM
+{
+	for(auto const &m : LB::events::metrics())
+	{
+		if(std::strcmp(m.name, name) == 0)
+		{
+			return m;
+		}
+	}
+	assert(false);
+	return {};
+}
+auto dispatches(EM::Phase const &p)
+-> std::uint64_t
+{
+	return std::accumulate(p.ns.begin(), p.ns.end(), std::uint64_t{});
+}
+
+int main() noexcept
+{
+	LEP<Base> bp {[](Base &){}};
+	LER<Base> br {[](Base const &){}};
+	LEP<Derived> dp1 {[](Derived &){}};
+	LEP<Derived> dp2 {[](Derived &){}};
+
+	Derived{}.call();
+	Derived{}.call();
+	std::vector<Derived> batch(3);
+	LB::events::call(batch.begin(), batch.end());
+
+	auto const d = find("Derived");
+	assert(d.processors == 2);
+	assert(d.reactors == 0);
+	assert(d.process.events == 5);
+	assert(d.react.events == 5);
+	assert(dispatches(d.process) == 3);
+
+	auto const b = find("Base");
+	assert(b.processors == 1);
+	assert(b.reactors == 1);
+	assert(b.react.events == 5);
+
+	//Registrars are created on first use, so Unused is not listed
+	for(auto const &m : LB::events::metrics())
+	{
+		assert(std::strcmp(m.name, "Unused") != 0);
+	}
+}
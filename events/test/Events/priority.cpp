@@ -0,0 +1,51 @@
+#undef NDEBUG
+
+#include "Event.hpp"
+
+#include <cassert>
+#include <vector>
+
+template<typename... Args>
+using EI = LB::events::Implementor<Args...>;
+template<typename... Args>
+using LEP = LB::events::LambdaProcessor<Args...>;
+template<typename... Args>
+using LER = LB::events::LambdaReactor<Args...>;
+using E = LB::events::Event;
+using LP = LB::events::ListenerPriority;
+
+struct TestEvent : EI<TestEvent, E> {}; LB_EVENTS_EVENT(TestEvent);
+
+std::vector<int> po {};
+std::vector<int> ro {};
+
+int main() noexcept
+{
+	LEP<TestEvent> p0 {[](TestEvent       &e){ po.push_back(0); }, 5};
+	LER<TestEvent> r0 {[](TestEvent const &e){ ro.push_back(0); }, 5};
+	LEP<TestEvent> p1 {[](TestEvent       &e){ po.push_back(1); }, LP::LAST};
+	LER<TestEvent> r1 {[](TestEvent const &e){ ro.push_back(1); }, LP::LAST};
+	LEP<TestEvent> p2 {[](TestEvent       &e){ po.push_back(2); }, -5};
+	LER<TestEvent> r2 {[](TestEvent const &e){ ro.push_back(2); }, -5};
+	LEP<TestEvent> p3 {[](TestEvent       &e){ po.push_back(3); }, 5};
+	LER<TestEvent> r3 {[](TestEvent const &e){ ro.push_back(3); }, 5};
+	LEP<TestEvent> p4 {[](TestEvent       &e){ po.push_back(4); }, LP::FIRST};
+	LER<TestEvent> r4 {[](TestEvent const &e){ ro.push_back(4); }, LP::FIRST};
+	TestEvent{}.call();
+	assert((po == std::vector<int>{4, 2, 0, 3, 1}));
+	assert(po == ro);
+	{
+		LEP<TestEvent> p5 {[](TestEvent       &e){ po.push_back(5); }, 5};
+		LER<TestEvent> r5 {[](TestEvent const &e){ ro.push_back(5); }, 5};
+		po.clear();
+		ro.clear();
+		TestEvent{}.call();
+		assert((po == std::vector<int>{4, 2, 0, 3, 5, 1}));
+		assert(po == ro);
+	}
+	po.clear();
+	ro.clear();
+	TestEvent{}.call();
+	assert((po == std::vector<int>{4, 2, 0, 3, 1}));
+	assert(po == ro);
+}
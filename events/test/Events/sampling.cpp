@@ -0,0 +1,119 @@
+#undef NDEBUG
+
+#include "Event.hpp"
+
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+template<typename... Args>
+using EI = LB::events::Implementor<Args...>;
+template<typename... Args>
+using ER = LB::events::Reactor<Args...>;
+template<typename... Args>
+using LER = LB::events::LambdaReactor<Args...>;
+using E = LB::events::Event;
+using S = LB::events::Sampling;
+
+struct Hot : EI<Hot, E>
+{
+	bool filtered = false;
+	virtual bool should_react(LB::events::ReactorBase const &) const noexcept override
+	{
+		return !filtered;
+	}
+};
+LB_EVENTS_EVENT(Hot);
+
+struct Counter final
+: ER<Hot>
+{
+	int n = 0;
+
+	Counter(S sampling) noexcept
+	: ER<Hot>(LB::events::ListenLater{})
+	{
+		listen(sampling);
+	}
+	using ER<Hot>::sample;
+
+private:
+	virtual void react(Hot const &) noexcept override
+	{
+		++n;
+	}
+};
+
+void call(int n)
+{
+	for(int i = 0; i < n; ++i)
+	{
+		Hot{}.call();
+	}
+}
+
+int main() noexcept
+{
+	//Every nth event, starting with the first
+	{
+		Counter all {S{}}, one {S::every(1)}, third {S::every(3)};
+		call(10);
+		assert(all.n == 10 && one.n == 10 && third.n == 4);
+
+		//Changing the policy starts over
+		third.sample(S::every(4));
+		call(5);
+		assert(third.n == 6);
+	}
+
+	//Events the event itself filters out do not count towards the sample
+	{
+		Counter half {S::every(2)};
+		Hot{}.call();
+		Hot filtered {};
+		filtered.filtered = true;
+		filtered.call();
+		Hot{}.call();
+		assert(half.n == 1);
+	}
+
+	//Each event independently with a probability
+	{
+		Counter none {S::probability(0)}, every {S::probability(1)}, quarter {S::probability(0.25)};
+		call(100000);
+		assert(none.n == 0 && every.n == 100000);
+		assert(quarter.n > 23000 && quarter.n < 27000);
+	}
+
+	//A token bucket which starts full with burst tokens
+	{
+		Counter limited {S::rate(10, 5)}, never {S::rate(0)};
+		auto const start = std::chrono::steady_clock::now();
+		call(1000);
+		auto const elapsed = std::chrono::steady_clock::now() - start;
+		assert(limited.n >= 5 && limited.n <= 5 + 10*std::chrono::duration_cast<std::chrono::seconds>(elapsed).count() + 1);
+		assert(never.n == 0);
+		auto const before = limited.n;
+		std::this_thread::sleep_for(std::chrono::milliseconds{250});
+		call(1000);
+		assert(limited.n > before && limited.n <= before + 5);
+	}
+
+	//Periods too long to count in nanoseconds still allow the first event
+	{
+		Counter glacial {S::rate(1e-300)}, bursty {S::rate(1e-12, 1e300)}, instant {S::rate(1e300, 1e300)};
+		call(10);
+		std::printf("%d %d %d\n", glacial.n, bursty.n, instant.n);
+	}
+
+	//Lambda reactors and batches
+	{
+		int n = 0;
+		LER<Hot> lambda {[&](Hot const &){ ++n; }, S::every(2)};
+		std::array<Hot, 5> batch {};
+		LB::events::call(batch.begin(), batch.end());
+		assert(n == 3);
+	}
+}
@@ -0,0 +1,136 @@
+#undef NDEBUG
+
+#include "Budgeted.hpp"
+#include "Event.hpp"
+#include "Exclusive.hpp"
+
+#include <array>
+#include <cassert>
+#include <string>
+
+template<typename... Args>
+using EI = LB::events::Implementor<Args...>;
+template<typename... Args>
+using LEP = LB::events::LambdaProcessor<Args...>;
+template<typename... Args>
+using LER = LB::events::LambdaReactor<Args...>;
+template<typename... Args>
+using ER = LB::events::Reactor<Args...>;
+using E = LB::events::Event;
+using LP = LB::events::ListenerPriority;
+
+std::string trace;
+
+struct Parent : EI<Parent, E>
+{
+	bool stop = false;
+};
+struct Child : EI<Child, Parent>
+{
+	int n = 0;
+};
+
+void parent_first(Parent &) { trace += "P"; }
+void parent_stop(Parent &p) { trace += "S"; if(p.stop) p.stop_processing(); }
+void parent_react(Parent const &) { trace += "R"; }
+void child_process(Child &c) { ++c.n; trace += "c"; }
+void child_react(Child const &c) { trace += std::to_string(c.n); }
+
+template<>
+struct LB::events::StaticListeners<Parent>
+: LB::events::StaticList
+<
+	LB::events::StaticProcessor<Parent, &parent_first, LP::FIRST>,
+	LB::events::StaticReactor<Parent, &parent_react>,
+	LB::events::StaticProcessor<Parent, &parent_stop, 5>
+>
+{
+};
+template<>
+struct LB::events::StaticListeners<Child>
+: LB::events::StaticList
+<
+	LB::events::StaticProcessor<Child, &child_process>,
+	LB::events::StaticReactor<Child, &child_react, LP::LAST>
+>
+{
+};
+LB_EVENTS_EVENT(Parent);
+LB_EVENTS_EVENT(Child);
+
+struct Job : EI<Job, LB::events::Exclusive>
+{
+	bool direct = false;
+};
+void job_react(Job const &) { trace += "J"; }
+template<>
+struct LB::events::StaticListeners<Job>
+: LB::events::StaticList<LB::events::StaticReactor<Job, &job_react>>
+{
+};
+LB_EVENTS_EVENT(Job);
+
+int main() noexcept
+{
+	//Static listeners need nothing to be listening
+	Child{}.call();
+	assert(trace == "PSc" "R1");
+	trace.clear();
+
+	//They run ahead of dynamic listeners of the same priority
+	LEP<Parent> p0 {[](Parent &){ trace += "p"; }};
+	LER<Parent> r0 {[](Parent const &){ trace += "r"; }};
+	LEP<Parent> p9 {[](Parent &){ trace += "q"; }, 9};
+	LER<Child> r9 {[](Child const &){ trace += "s"; }, LP::LAST};
+	Child{}.call();
+	assert(trace == "PpSqc" "Rr1s");
+	trace.clear();
+
+	//Stopping processing stops static processors too
+	Child stopped {};
+	stopped.stop = true;
+	stopped.call();
+	assert(trace == "PpS" "Rr0s");
+	trace.clear();
+
+	//Batches call each static listener with the whole range in turn
+	std::array<Child, 2> batch {};
+	LB::events::call(batch.begin(), batch.end());
+	assert(trace == "PPppSSqqcc" "RRrr11ss");
+	trace.clear();
+
+	//Budgeted dispatch resumes static reactors in the same order
+	LB::events::BudgetedDispatcher dispatcher {-1};
+	dispatcher.call(Child{});
+	assert(trace == "PpSqc");
+	assert(!dispatcher.run(LB::events::BudgetedDispatcher::Clock_t::now()));
+	dispatcher.flush();
+	assert(trace == "PpSqc" "Rr" "1s");
+	trace.clear();
+
+	//An Exclusive event reacts with only the reactor which claimed it, however it was claimed
+	{
+		LER<Job> worker {[](Job const &){ trace += "w"; }};
+		LEP<Job> claimer {[&](Job &j)
+		{
+			if(j.direct)
+			{
+				j.claim(static_cast<ER<Job> &>(worker));
+			}
+			else
+			{
+				j.claim(&worker);
+			}
+		}};
+		Job{}.call();
+		Job direct {};
+		direct.direct = true;
+		direct.call();
+		std::array<Job, 2> jobs {};
+		LB::events::call(jobs.begin(), jobs.end());
+		dispatcher.call(Job{});
+		dispatcher.flush();
+		assert(trace == "wwwww");
+		trace.clear();
+	}
+}
@@ -0,0 +1,122 @@
+#undef NDEBUG
+
+#include "Exclusive.hpp"
+
+#include <cassert>
+#include <memory>
+#include <vector>
+
+template<typename... Args>
+using EventImplementor = LB::events::Implementor<Args...>;
+template<typename... Args>
+using EventReactor = LB::events::Reactor<Args...>;
+template<typename... Args>
+using LambdaEventProcessor = LB::events::LambdaProcessor<Args...>;
+using ExclusiveEvent = LB::events::Exclusive;
+
+int checks = 0;
+
+struct JobEvent
+: EventImplementor<JobEvent, ExclusiveEvent>
+{
+	virtual bool should_react(LB::events::ReactorBase const &r) const noexcept override
+	{
+		++checks;
+		return ExclusiveEvent::should_react(r);
+	}
+};
+LB_EVENTS_EVENT(JobEvent);
+
+template<typename EventT>
+struct Worker
+: EventReactor<EventT>
+{
+	int jobs = 0;
+	void quit() noexcept
+	{
+		this->ignore();
+	}
+
+private:
+	virtual void react(EventT const &) noexcept override
+	{
+		++jobs;
+	}
+};
+
+int main() noexcept
+{
+	std::vector<std::unique_ptr<Worker<JobEvent>>> workers;
+	for(int i = 0; i < 1000; ++i)
+	{
+		workers.emplace_back(new Worker<JobEvent>);
+	}
+	Worker<ExclusiveEvent> generic;
+	LB::events::ReactorBase *winner = nullptr;
+	LambdaEventProcessor<JobEvent> dispatcher {[&](JobEvent &e)
+	{
+		if(winner == workers[500].get())
+		{
+			e.claim(static_cast<EventReactor<JobEvent> &>(*workers[500]));
+		}
+		else if(winner == &generic)
+		{
+			e.claim(static_cast<EventReactor<ExclusiveEvent> &>(generic));
+		}
+	}};
+
+	//Only the claimed reactor is visited
+	winner = workers[500].get();
+	JobEvent{}.call();
+	assert(workers[500]->jobs == 1);
+	assert(checks == 1);
+
+	//It may react to any event type in the hierarchy
+	winner = &generic;
+	JobEvent{}.call();
+	assert(generic.jobs == 1);
+	assert(workers[500]->jobs == 1);
+	assert(checks == 2);
+
+	//Nobody reacts to an unclaimed event
+	winner = nullptr;
+	JobEvent{}.call();
+	assert(checks == 2);
+
+	//A claimed reactor which stopped listening is not called
+	winner = workers[500].get();
+	assert(JobEvent::listening(*workers[500]));
+	workers[500]->quit();
+	assert(!JobEvent::listening(*workers[500]));
+	JobEvent{}.call();
+	assert(workers[500]->jobs == 1);
+	winner = nullptr;
+
+	//Nor is one destroyed after claiming, which is never touched again
+	std::unique_ptr<Worker<JobEvent>> claimed;
+	std::unique_ptr<Worker<JobEvent>> successor;
+	LambdaEventProcessor<JobEvent> reclaimer {[&](JobEvent &e)
+	{
+		if(claimed)
+		{
+			e.claim(static_cast<EventReactor<JobEvent> &>(*claimed));
+			claimed.reset();
+		}
+	}};
+	claimed.reset(new Worker<JobEvent>);
+	JobEvent{}.call();
+
+	//Nor the reactor which listened next in its place
+	auto const previous = workers[0].get();
+	LambdaEventProcessor<JobEvent> replacer {[&](JobEvent &e)
+	{
+		if(previous->jobs == 0 && !successor)
+		{
+			e.claim(static_cast<EventReactor<JobEvent> &>(*previous));
+			previous->quit();
+			successor.reset(new Worker<JobEvent>);
+		}
+	}};
+	JobEvent{}.call();
+	assert(previous->jobs == 0 && successor->jobs == 0);
+}
@@ -0,0 +1,149 @@
+#undef NDEBUG
+
+#include "Journal.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+template<typename... Args>
+using EventImplementor = LB::events::Implementor<Args...>;
+template<typename... Args>
+using LambdaEventProcessor = LB::events::LambdaProcessor<Args...>;
+template<typename... Args>
+using LambdaEventReactor = LB::events::LambdaReactor<Args...>;
+using Event = LB::events::Event;
+using JournaledEvent = LB::events::Journaled;
+template<typename EventT>
+using JournalType = LB::events::JournalType<EventT>;
+
+struct Order
+: EventImplementor<Order, JournaledEvent>
+, JournalType<Order>
+{
+	static constexpr JournaledEvent::Type_t JOURNAL_TYPE = 1;
+
+	int quantity;
+	std::string item;
+	Order(int quantity, std::string item)
+	: quantity{quantity}
+	, item{std::move(item)}
+	{
+	}
+
+	virtual void save(LB::events::JournalWriter &w) const override
+	{
+		w.write(quantity);
+		w.write(static_cast<std::uint32_t>(item.size()));
+		w.write(item.data(), item.size());
+	}
+	static auto load(LB::events::JournalReader &r)
+	-> Order
+	{
+		auto const quantity = r.read<int>();
+		std::string item(r.read<std::uint32_t>(), '\0');
+		r.read(&item[0], item.size());
+		return {quantity, item};
+	}
+};
+LB_EVENTS_EVENT(Order);
+
+struct Tick
+: EventImplementor<Tick, JournaledEvent>
+, JournalType<Tick>
+{
+	static constexpr JournaledEvent::Type_t JOURNAL_TYPE = 2;
+
+	virtual void save(LB::events::JournalWriter &) const override
+	{
+	}
+	static auto load(LB::events::JournalReader &)
+	-> Tick
+	{
+		return {};
+	}
+};
+LB_EVENTS_EVENT(Tick);
+
+struct Unrecorded : EventImplementor<Unrecorded, Event> {}; LB_EVENTS_EVENT(Unrecorded);
+
+//Fails part way through saving itself
+struct Broken
+: EventImplementor<Broken, JournaledEvent>
+, JournalType<Broken>
+{
+	static constexpr JournaledEvent::Type_t JOURNAL_TYPE = 3;
+
+	virtual void save(LB::events::JournalWriter &w) const override
+	{
+		w.write(JOURNAL_TYPE);
+		throw std::runtime_error{"broken"};
+	}
+	static auto load(LB::events::JournalReader &)
+	-> Broken
+	{
+		return {};
+	}
+};
+LB_EVENTS_EVENT(Broken);
+
+int main()
+{
+	char const *path = "test-Journal-basic.journal";
+	std::vector<std::string> seen;
+	//Processing still happens after recording, and is repeated by the replay
+	LambdaEventProcessor<Order> doubler {[](Order &e){ e.quantity *= 2; }};
+	LambdaEventReactor<Order> orders {[&](Order const &e){ seen.push_back(e.item + std::to_string(e.quantity)); }};
+	LambdaEventReactor<Tick> ticks {[&](Tick const &){ seen.push_back("tick"); }};
+	{
+		LB::events::Journal journal {path, 64};
+		for(int i = 0; i < 1000; ++i)
+		{
+			Order{i, "item"}.call();
+			Tick{}.call();
+			Unrecorded{}.call();
+			if(i % 100 == 0)
+			{
+				//An event which fails to save is not recorded at all
+				auto const before = journal.size();
+				bool thrown = false;
+				try
+				{
+					Broken{}.call();
+				}
+				catch(std::runtime_error const &)
+				{
+					thrown = true;
+				}
+				assert(thrown && journal.size() == before);
+			}
+		}
+		assert(journal.size() > 64);
+	}
+	auto const recorded = seen;
+	assert(recorded.size() == 2000);
+	assert(recorded[2] == "item2");
+
+	seen.clear();
+	{
+		LB::events::JournalReplay replay {path};
+		replay.load<Order>();
+		replay.load<Tick>();
+		replay.load<Broken>();
+		assert(replay.replay() == 2000);
+	}
+	assert(seen == recorded);
+
+	//Types which were not loaded are skipped
+	seen.clear();
+	{
+		LB::events::JournalReplay replay {path};
+		replay.load<Tick>();
+		assert(replay.replay() == 1000);
+	}
+	assert(seen.size() == 1000 && seen.front() == "tick");
+	std::remove(path);
+}
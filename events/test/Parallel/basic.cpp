@@ -0,0 +1,120 @@
+#undef NDEBUG
+
+#include "Parallel.hpp"
+#include "Domain.hpp"
+#include "Event.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+template<typename... Args>
+using EventImplementor = LB::events::Implementor<Args...>;
+template<typename... Args>
+using EventReactor = LB::events::Reactor<Args...>;
+using Event = LB::events::Event;
+
+struct E0 : EventImplementor<E0, Event> {}; LB_EVENTS_EVENT(E0);
+struct E1 : EventImplementor<E1, E0> {}; LB_EVENTS_EVENT(E1);
+struct E2 : EventImplementor<E2, Event> {}; LB_EVENTS_EVENT(E2);
+
+std::atomic<int> active {0};
+std::atomic<int> most {0};
+std::atomic<int> finished {0};
+bool ordered = true;
+bool fail = false;
+
+struct SlowReactor
+: EventReactor<E1>
+{
+	SlowReactor() noexcept
+	: EventReactor<E1>(LB::events::ListenLater{})
+	{
+		parallel(true);
+		listen();
+	}
+
+private:
+	virtual void react(E1 const &e) override
+	{
+		auto const now = ++active;
+		for(auto m = most.load(); now > m && !most.compare_exchange_weak(m, now); )
+		{
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		--active;
+		++finished;
+		if(fail)
+		{
+			throw std::runtime_error{"fail"};
+		}
+	}
+};
+
+struct DomainReactor
+: EventReactor<E2>
+{
+	LB::events::EventDomain const &d;
+	bool in_domain = false;
+	DomainReactor(LB::events::EventDomain const &d) noexcept
+	: EventReactor<E2>(LB::events::ListenLater{})
+	, d(d)
+	{
+		parallel(true);
+		listen();
+	}
+
+private:
+	virtual void react(E2 const &) override
+	{
+		in_domain = LB::events::EventDomain::current() == &d;
+	}
+};
+
+int main()
+{
+	auto const first = LB::events::lambda_reactor<E0>([](E0 const &e){ ordered = ordered && finished == 0; });
+	std::vector<std::unique_ptr<SlowReactor>> slow;
+	for(int i = 0; i < 6; ++i)
+	{
+		slow.emplace_back(new SlowReactor);
+	}
+	auto const last = LB::events::lambda_reactor<E1>([](E1 const &e){ ordered = ordered && finished == 6; }, 1);
+
+	E1{}.call();
+	assert(ordered && most == 1);
+
+	{
+		LB::events::WorkStealingPool pool {4};
+		LB::events::parallel_executor(&pool);
+		finished = 0;
+		E1{}.call();
+		assert(ordered && most > 1);
+
+		fail = true;
+		bool thrown = false;
+		try
+		{
+			E1{}.call();
+		}
+		catch(std::runtime_error const &)
+		{
+			thrown = true;
+		}
+		assert(thrown);
+
+		//Workers react in the caller's domain
+		LB::events::EventDomain d;
+		{
+			LB::events::EventDomain::Scope const scope {d};
+			DomainReactor r[2] {{d}, {d}};
+			E2{}.call();
+			assert(r[0].in_domain && r[1].in_domain);
+		}
+		LB::events::parallel_executor(nullptr);
+	}
+}
@@ -0,0 +1,102 @@
+#undef NDEBUG
+
+#include "Pipeline.hpp"
+#include "Cancellable.hpp"
+
+#include <cassert>
+#include <thread>
+#include <vector>
+
+template<typename... Args>
+using EventImplementor = LB::events::Implementor<Args...>;
+template<typename... Args>
+using EventProcessor = LB::events::Processor<Args...>;
+template<typename... Args>
+using EventReactor = LB::events::Reactor<Args...>;
+template<typename... Args>
+using LambdaEventReactor = LB::events::LambdaReactor<Args...>;
+using CancellableEvent = LB::events::Cancellable;
+using Domain = LB::events::EventDomain;
+
+struct TestEvent
+: EventImplementor<TestEvent, CancellableEvent>
+{
+	int x;
+	std::thread::id processed_on;
+	TestEvent(int x) noexcept
+	: x(x)
+	{
+	}
+};
+LB_EVENTS_EVENT(TestEvent);
+struct Ping
+: EventImplementor<Ping, LB::events::Event>
+{
+};
+LB_EVENTS_EVENT(Ping);
+
+std::vector<int> reacted;
+bool off_thread = true;
+
+struct TestListener
+: private EventProcessor<TestEvent>
+, private EventReactor<TestEvent>
+{
+private:
+	virtual void process(TestEvent &e) const noexcept override
+	{
+		e.processed_on = std::this_thread::get_id();
+		e.cancelled(e.x % 3 == 0);
+	}
+	virtual void react(TestEvent const &e) noexcept override
+	{
+		off_thread = off_thread && e.processed_on == main_thread && std::this_thread::get_id() != main_thread;
+		reacted.push_back(e.x);
+	}
+
+public:
+	std::thread::id const main_thread = std::this_thread::get_id();
+} listener;
+
+int main() noexcept
+{
+	{
+		LB::events::Pipeline pipeline;
+		for(int i = 1; i <= 100; ++i)
+		{
+			pipeline.call(TestEvent{i});
+		}
+		pipeline.flush();
+		assert(reacted.size() == 67);
+		for(int i = 101; i <= 200; ++i)
+		{
+			TestEvent e {i};
+			pipeline.call(e);
+		}
+	}
+	assert(reacted.size() == 134);
+	for(std::size_t i = 1; i < reacted.size(); ++i)
+	{
+		assert(reacted[i - 1] < reacted[i]);
+		assert(reacted[i] % 3 != 0);
+	}
+	assert(off_thread);
+
+	//Events react in the domain they were called in
+	{
+		int global = 0, local = 0;
+		Domain const *seen = nullptr;
+		LambdaEventReactor<Ping> r0 {[&](Ping const &){ ++global; }};
+		Domain d;
+		LB::events::Pipeline pipeline;
+		{
+			Domain::Scope const scope {d};
+			LambdaEventReactor<Ping> r {[&](Ping const &){ ++local; seen = Domain::current(); }};
+			pipeline.call(Ping{});
+			pipeline.flush();
+		}
+		pipeline.call(Ping{});
+		pipeline.flush();
+		assert(local == 1 && global == 1 && seen == &d);
+	}
+}
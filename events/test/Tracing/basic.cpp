@@ -0,0 +1,90 @@
+#undef NDEBUG
+
+#include "Tracing.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <thread>
+
+template<typename... Args>
+using EI = LB::events::Implementor<Args...>;
+template<typename... Args>
+using LEP = LB::events::LambdaProcessor<Args...>;
+template<typename... Args>
+using LER = LB::events::LambdaReactor<Args...>;
+using E = LB::events::Event;
+
+struct Parent : EI<Parent, E>
+{
+};
+LB_EVENTS_EVENT(Parent);
+struct Child : EI<Child, Parent>
+{
+};
+LB_EVENTS_EVENT(Child);
+
+auto trace()
+-> std::string
+{
+	std::ostringstream out;
+	LB::events::write_trace(out);
+	return out.str();
+}
+auto count(std::string const &s, std::string const &what) noexcept
+-> std::size_t
+{
+	std::size_t n = 0;
+	for(auto i = s.find(what); i != std::string::npos; i = s.find(what, i + 1))
+	{
+		++n;
+	}
+	return n;
+}
+
+int main() noexcept
+{
+	LEP<Parent> p {[](Parent &){}};
+	LER<Child> r {[](Child const &){}};
+
+	//Nothing is recorded until tracing is turned on
+	Child{}.call();
+	assert(!LB::events::tracing());
+	assert(count(trace(), "\"ph\"") == 0);
+
+	LB::events::tracing(true);
+	Child{}.call();
+	std::thread{[]{ Child{}.call(); }}.join();
+	LB::events::tracing(false);
+	Child{}.call();
+
+	//One call per thread, each with the phases of the classes which have listeners for them and
+	//both listeners, nested
+	auto const t = trace();
+	assert(count(t, "\"name\": \"call\"") == 2);
+	assert(count(t, "\"name\": \"LB::events::Event process\"") == 0);
+	assert(count(t, "\"name\": \"Parent process\"") == 2);
+	assert(count(t, "\"name\": \"Child process\"") == 0);
+	assert(count(t, "\"name\": \"Parent react\"") == 0);
+	assert(count(t, "\"name\": \"Child react\"") == 2);
+	assert(count(t, "\"name\": \"processor\"") == 2);
+	assert(count(t, "\"name\": \"reactor\"") == 2);
+	assert(count(t, "\"ph\": \"B\"") == 10 && count(t, "\"ph\": \"E\"") == 10);
+	assert(count(t, "\"tid\": 1") == 10 && count(t, "\"tid\": 2") == 10);
+	assert(t.find("\"name\": \"call\"") < t.find("\"name\": \"Parent process\"") && t.find("\"name\": \"Parent process\"") < t.find("\"name\": \"processor\""));
+
+	//Only the most recent records are kept, and spans which began before them are left out
+	LB::events::tracing(true);
+	for(int i = 0; i < 10000; ++i)
+	{
+		Child{}.call();
+	}
+	LB::events::tracing(false);
+	auto const wrapped = trace();
+	auto const begins = count(wrapped, "\"ph\": \"B\"");
+	auto const ends = count(wrapped, "\"ph\": \"E\"");
+	assert(begins == ends);
+	assert(begins + ends <= 10 + LB::events::impl::Trace::Buffer::CAPACITY);
+	assert(begins > LB::events::impl::Trace::Buffer::CAPACITY/4);
+}